@@ -0,0 +1,354 @@
+// Copyright (c) 2017-2019 Daniel Lovasko
+// All Rights Reserved
+//
+// Distributed under the terms of the 2-clause BSD License. The full
+// license is in the file LICENSE, distributed as part of this software.
+
+#ifndef DLIST_H
+#define DLIST_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "list.h"
+
+
+////////////////////////////////////////////
+// Function            // Time complexity //
+////////////////////////////////////////////
+// DLIST_LINK          // compile time    //
+// DLIST_TYPE          // compile time    //
+// DLIST_FIRST         // O(1)            //
+// DLIST_LAST          // O(1)            //
+// DLIST_NEXT          // O(1)            //
+// DLIST_PREV          // O(1)            //
+// DLIST_NEW           // O(1)            //
+// DLIST_EMPTY         // O(1)            //
+// DLIST_MAP           // O(n)            //
+// DLIST_FILTER        // O(n)            //
+// DLIST_PUSH_FRONT    // O(1)            //
+// DLIST_PUSH_BACK     // O(1)            //
+// DLIST_POP_FRONT     // O(1)            //
+// DLIST_POP_BACK      // O(1)            //
+// DLIST_INSERT_AFTER  // O(1)            //
+// DLIST_INSERT_BEFORE // O(1)            //
+// DLIST_REMOVE        // O(1)            //
+// DLIST_FREE          // O(n)            //
+// DLIST_SORT          // O(n * log n)    //
+// DLIST_APPEND        // O(1)            //
+// DLIST_LENGTH        // O(n)            //
+////////////////////////////////////////////
+
+// The doubly linked list shares the field names of the singly linked list,
+// and therefore all LIST_* macros that do not modify the list (e.g. LIST_FIND,
+// LIST_NTH, LIST_ALL or LIST_MEMBER) can be used on it directly.
+
+/// Definition of a new doubly linked element link.
+///
+/// @param[in] tag struct tag name
+#define DLIST_LINK(tag)    \
+  struct {                 \
+    struct tag* _list_nxt; \
+    struct tag* _list_prv; \
+  }
+
+/// Definition of a new doubly linked list type.
+///
+/// @param[in] tag  struct tag name
+/// @param[in] type list element type
+#define DLIST_TYPE(tag, type) \
+  struct tag {                \
+    type* _list_fst;          \
+    type* _list_lst;          \
+  }
+
+/// Internal function to access the previous linked element.
+/// Please note that this function is for internal use only and should not be
+/// used in your code.
+/// @return NULL if no element is linked, previous element otherwise
+///
+/// @param[in] elem element
+/// @param[in] link element link name
+#define _DLIST_PRV(elem, link) \
+  ((elem)->link._list_prv)
+
+/// Internal function to access the last element of the list.
+/// Please note that this function is for internal use only and should not be
+/// used in your code.
+/// @return NULL if empty, last element otherwise
+///
+/// @param[in] list list
+#define _DLIST_LST(list) \
+  ((list)->_list_lst)
+
+/// Obtain the first element of the list.
+///
+/// @param[out] out  first element
+/// @param[in]  list list
+#define DLIST_FIRST(out, list) \
+  LIST_FIRST(out, list)
+
+/// Obtain the last element of the list.
+///
+/// @param[out] out  last element (NULL if the list is empty)
+/// @param[in]  list list
+#define DLIST_LAST(out, list)  \
+  do {                         \
+    *(out) = _DLIST_LST(list); \
+  } while (0)
+
+/// Obtain the next linked element.
+///
+/// @param[out] out  next element
+/// @param[in]  elem element
+/// @param[in]  link element link name
+#define DLIST_NEXT(out, elem, link) \
+  LIST_NEXT(out, elem, link)
+
+/// Obtain the previous linked element.
+///
+/// @param[out] out  previous element
+/// @param[in]  elem element
+/// @param[in]  link element link name
+#define DLIST_PREV(out, elem, link)  \
+  do {                               \
+    *(out) = _DLIST_PRV(elem, link); \
+  } while (0)
+
+/// Initialise the list.
+///
+/// @param[in] list list
+#define DLIST_NEW(list)      \
+  do {                       \
+    _LIST_FST(list) = NULL;  \
+    _DLIST_LST(list) = NULL; \
+  } while (0)
+
+/// Determine whether the list is empty.
+///
+/// @param[out] out  decision
+/// @param[in]  list list
+#define DLIST_EMPTY(out, list) \
+  LIST_EMPTY(out, list)
+
+/// Traverse the list and execute a function for each element.
+///
+/// @param[in] list list
+/// @param[in] type element C type name
+/// @param[in] link element link name
+/// @param[in] func function
+/// @param[in] ...  variable-length arguments for the function
+#define DLIST_MAP(list, type, link, func, ...) \
+  LIST_MAP(list, type, link, func, __VA_ARGS__)
+
+/// Insert an element to the head of the list.
+///
+/// @param[in] list list
+/// @param[in] elem element
+/// @param[in] link element link name
+#define DLIST_PUSH_FRONT(list, elem, link)             \
+  do {                                                 \
+    _DLIST_PRV(elem, link) = NULL;                     \
+    _LIST_NXT(elem, link) = _LIST_FST(list);           \
+    if (_LIST_FST(list) != NULL)                       \
+      _DLIST_PRV(_LIST_FST(list), link) = (elem);      \
+    else                                               \
+      _DLIST_LST(list) = (elem);                       \
+    _LIST_FST(list) = (elem);                          \
+  } while (0)
+
+/// Insert an element to the tail of the list.
+///
+/// @param[in] list list
+/// @param[in] elem element
+/// @param[in] link element link name
+#define DLIST_PUSH_BACK(list, elem, link)              \
+  do {                                                 \
+    _LIST_NXT(elem, link) = NULL;                      \
+    _DLIST_PRV(elem, link) = _DLIST_LST(list);         \
+    if (_DLIST_LST(list) != NULL)                      \
+      _LIST_NXT(_DLIST_LST(list), link) = (elem);      \
+    else                                               \
+      _LIST_FST(list) = (elem);                        \
+    _DLIST_LST(list) = (elem);                         \
+  } while (0)
+
+/// Insert an element after the specified element.
+///
+/// @param[in] list  list
+/// @param[in] elem  element
+/// @param[in] toadd element to be added
+/// @param[in] link  element link name
+#define DLIST_INSERT_AFTER(list, elem, toadd, link)          \
+  do {                                                       \
+    _DLIST_PRV(toadd, link) = (elem);                        \
+    _LIST_NXT(toadd, link) = _LIST_NXT(elem, link);          \
+    if (_LIST_NXT(elem, link) != NULL)                       \
+      _DLIST_PRV(_LIST_NXT(elem, link), link) = (toadd);     \
+    else                                                     \
+      _DLIST_LST(list) = (toadd);                            \
+    _LIST_NXT(elem, link) = (toadd);                         \
+  } while (0)
+
+/// Insert an element before the specified element.
+///
+/// @param[in] list  list
+/// @param[in] elem  element
+/// @param[in] toadd element to be added
+/// @param[in] link  element link name
+#define DLIST_INSERT_BEFORE(list, elem, toadd, link)         \
+  do {                                                       \
+    _LIST_NXT(toadd, link) = (elem);                         \
+    _DLIST_PRV(toadd, link) = _DLIST_PRV(elem, link);        \
+    if (_DLIST_PRV(elem, link) != NULL)                      \
+      _LIST_NXT(_DLIST_PRV(elem, link), link) = (toadd);     \
+    else                                                     \
+      _LIST_FST(list) = (toadd);                             \
+    _DLIST_PRV(elem, link) = (toadd);                        \
+  } while (0)
+
+/// Internal function to unlink an element from the list.
+/// Please note that this function is for internal use only and should not be
+/// used in your code.
+///
+/// @param[in] list list
+/// @param[in] elem element
+/// @param[in] link element link name
+#define _DLIST_UNLINK(list, elem, link)                                 \
+  do {                                                                  \
+    if (_DLIST_PRV(elem, link) != NULL)                                 \
+      _LIST_NXT(_DLIST_PRV(elem, link), link) = _LIST_NXT(elem, link);  \
+    else                                                                \
+      _LIST_FST(list) = _LIST_NXT(elem, link);                          \
+    if (_LIST_NXT(elem, link) != NULL)                                  \
+      _DLIST_PRV(_LIST_NXT(elem, link), link) = _DLIST_PRV(elem, link); \
+    else                                                                \
+      _DLIST_LST(list) = _DLIST_PRV(elem, link);                        \
+    _LIST_NXT(elem, link) = NULL;                                       \
+    _DLIST_PRV(elem, link) = NULL;                                      \
+  } while (0)
+
+/// Remove the specified element from the list.
+///
+/// @param[in] list  list
+/// @param[in] elem  element
+/// @param[in] link  element link name
+/// @param[in] clean deallocation function
+#define DLIST_REMOVE(list, elem, link, clean) \
+  do {                                        \
+    _DLIST_UNLINK(list, elem, link);          \
+    if (clean != NULL)                        \
+      clean(elem);                            \
+  } while (0)
+
+/// Remove an element from the head of the list.
+///
+/// @param[in] list  list
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+/// @param[in] clean deallocation function
+#define DLIST_POP_FRONT(list, type, link, clean)  \
+  do {                                            \
+    type* _list_e = _LIST_FST(list);              \
+    if (_list_e != NULL)                          \
+      DLIST_REMOVE(list, _list_e, link, clean);   \
+  } while (0)
+
+/// Remove an element from the tail of the list.
+///
+/// @param[in] list  list
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+/// @param[in] clean deallocation function
+#define DLIST_POP_BACK(list, type, link, clean)   \
+  do {                                            \
+    type* _list_e = _DLIST_LST(list);             \
+    if (_list_e != NULL)                          \
+      DLIST_REMOVE(list, _list_e, link, clean);   \
+  } while (0)
+
+/// Remove all elements from the list.
+///
+/// @param[in] list  list
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+/// @param[in] clean deallocation function
+#define DLIST_FREE(list, type, link, clean)      \
+  do {                                           \
+    while (_LIST_FST(list) != NULL)              \
+      DLIST_POP_FRONT(list, type, link, clean);  \
+  } while (0)
+
+/// Traverse the list and remove elements that fail for a predicate.
+///
+/// @param[in] list  list
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+/// @param[in] clean deallocation function
+/// @param[in] func  predicate
+/// @param[in] ...   variable-length arguments for the predicate
+#define DLIST_FILTER(list, type, link, clean, func, ...) \
+  do {                                                   \
+    type* _list_e = _LIST_FST(list);                     \
+    type* _list_n;                                       \
+    intmax_t _list_i = 0;                                \
+    while (_list_e != NULL) {                            \
+      _list_n = _LIST_NXT(_list_e, link);                \
+      if (func(_list_e, _list_i, __VA_ARGS__))           \
+        DLIST_REMOVE(list, _list_e, link, clean);        \
+      _list_e = _list_n;                                 \
+      _list_i++;                                         \
+    }                                                    \
+  } while (0)
+
+/// Sort the elements in the list.
+///
+/// The elements are sorted by LIST_SORT along the forward links, followed by
+/// a single pass that restores the backward links and the tail of the list.
+///
+/// @param[in] list list
+/// @param[in] type element C type name
+/// @param[in] link element link name
+/// @param[in] func comparator function
+/// @param[in] ...  variable-length arguments for the comparator function
+#define DLIST_SORT(list, type, link, func, ...)             \
+  do {                                                      \
+    type* _list_p = NULL;                                   \
+    LIST_SORT(list, type, link, func, __VA_ARGS__);         \
+    for (type* _list_e = _LIST_FST(list);                   \
+         _list_e != NULL;                                   \
+         _list_e = _LIST_NXT(_list_e, link)) {              \
+      _DLIST_PRV(_list_e, link) = _list_p;                  \
+      _list_p = _list_e;                                    \
+    }                                                       \
+    _DLIST_LST(list) = _list_p;                             \
+  } while (0)
+
+/// Append elements from one list to the end of another one.
+///
+/// @param[in] list1 first list
+/// @param[in] list2 second list
+/// @param[in] link  element link name
+#define DLIST_APPEND(list1, list2, link)                          \
+  do {                                                            \
+    if (_LIST_FST(list2) == NULL)                                 \
+      break;                                                      \
+    if (_DLIST_LST(list1) == NULL) {                              \
+      _LIST_FST(list1) = _LIST_FST(list2);                        \
+    } else {                                                      \
+      _LIST_NXT(_DLIST_LST(list1), link) = _LIST_FST(list2);      \
+      _DLIST_PRV(_LIST_FST(list2), link) = _DLIST_LST(list1);     \
+    }                                                             \
+    _DLIST_LST(list1) = _DLIST_LST(list2);                        \
+    DLIST_NEW(list2);                                             \
+  } while (0)
+
+/// Compute the length of the list.
+///
+/// @param[out] out  length of the list (zero if empty)
+/// @param[in]  list list
+/// @param[in]  type element C type name
+/// @param[in]  link element link name
+#define DLIST_LENGTH(out, list, type, link) \
+  LIST_LENGTH(out, list, type, link)
+#endif
@@ -0,0 +1,273 @@
+// Copyright (c) 2017-2019 Daniel Lovasko
+// All Rights Reserved
+//
+// Distributed under the terms of the 2-clause BSD License. The full
+// license is in the file LICENSE, distributed as part of this software.
+
+#ifndef HASH_H
+#define HASH_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "list.h"
+
+
+//////////////////////////////////////
+// Function      // Time complexity //
+//////////////////////////////////////
+// HASH_TYPE    // compile time     //
+// HASH_NEW     // O(n)             //
+// HASH_INSERT  // O(1)             //
+// HASH_FIND    // O(1) average     //
+// HASH_REMOVE  // O(1) average     //
+// HASH_MAP     // O(n)             //
+// HASH_LENGTH  // O(1)             //
+// HASH_FREE    // O(n)             //
+//////////////////////////////////////
+
+// The hash table consists of buckets that are ordinary lists, and therefore
+// the elements are linked by a LIST_LINK. The table grows once the number of
+// elements exceeds the number of buckets. Instead of rehashing all elements
+// at once, the previous bucket array is retained and each subsequent
+// insertion or removal migrates HASH_STEP of its buckets to the new array,
+// until the previous array is empty and can be released. As another growth
+// requires as many insertions as there are buckets in the previous array, the
+// migration always finishes before the table grows again. Lookups search both
+// arrays and never modify the table, so that they can be performed
+// concurrently under a shared lock.
+//
+// The hash function is called as hfunc(elem) and returns a size_t, the
+// equality function is called as efunc(elem, key) and returns a bool. The
+// key is an element of the same type that carries the looked-up fields.
+
+/// Number of buckets migrated to the new bucket array by each operation.
+#ifndef HASH_STEP
+  #define HASH_STEP 4
+#endif
+
+/// Definition of a new hash table type.
+///
+/// @param[in] tag  struct tag name
+/// @param[in] type element type
+#define HASH_TYPE(tag, type)   \
+  struct tag {                 \
+    struct {                   \
+      type* _list_fst;         \
+    }* _hash_tab[2];           \
+    size_t _hash_cap[2];       \
+    size_t _hash_mov;          \
+    size_t _hash_cnt;          \
+  }
+
+/// Internal function to compute the bucket index of a hash value.
+/// Please note that this function is for internal use only and should not be
+/// used in your code.
+/// @return bucket index
+///
+/// @param[in] hash hash table
+/// @param[in] t    bucket array (0 for the current, 1 for the previous)
+/// @param[in] h    hash value
+#define _HASH_IDX(hash, t, h) \
+  ((size_t)(h) & ((hash)->_hash_cap[t] - 1))
+
+/// Internal function to migrate buckets from the previous bucket array.
+/// Please note that this function is for internal use only and should not be
+/// used in your code.
+///
+/// @param[in] hash  hash table
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+/// @param[in] hfunc hash function
+#define _HASH_MIGRATE(hash, type, link, hfunc)                              \
+  do {                                                                      \
+    type** _hash_c;                                                         \
+    type* _hash_e;                                                          \
+    size_t _hash_b;                                                         \
+    for (int _hash_k = 0;                                                   \
+         _hash_k < HASH_STEP && (hash)->_hash_tab[1] != NULL;               \
+         _hash_k++) {                                                       \
+      _hash_c = &(hash)->_hash_tab[1][(hash)->_hash_mov]._list_fst;         \
+      while ((_hash_e = *_hash_c) != NULL) {                                \
+        *_hash_c = _LIST_NXT(_hash_e, link);                                \
+        _hash_b = _HASH_IDX(hash, 0, hfunc(_hash_e));                       \
+        LIST_PUSH(&(hash)->_hash_tab[0][_hash_b], _hash_e, link);           \
+      }                                                                     \
+      (hash)->_hash_mov++;                                                  \
+      if ((hash)->_hash_mov == (hash)->_hash_cap[1]) {                      \
+        free((hash)->_hash_tab[1]);                                         \
+        (hash)->_hash_tab[1] = NULL;                                        \
+      }                                                                     \
+    }                                                                       \
+  } while (0)
+
+/// Initialise the hash table.
+///
+/// @param[out] out  success/failure
+/// @param[in]  hash hash table
+/// @param[in]  n    initial number of buckets (rounded up to a power of two)
+#define HASH_NEW(out, hash, n)                                         \
+  do {                                                                 \
+    (hash)->_hash_cap[0] = 1;                                          \
+    while ((hash)->_hash_cap[0] < (size_t)(n))                         \
+      (hash)->_hash_cap[0] *= 2;                                       \
+    (hash)->_hash_cap[1] = 0;                                          \
+    (hash)->_hash_tab[0] = calloc((hash)->_hash_cap[0],                \
+                                  sizeof(*(hash)->_hash_tab[0]));      \
+    (hash)->_hash_tab[1] = NULL;                                       \
+    (hash)->_hash_mov = 0;                                             \
+    (hash)->_hash_cnt = 0;                                             \
+    *(out) = ((hash)->_hash_tab[0] != NULL);                           \
+  } while (0)
+
+/// Insert an element to the hash table.
+///
+/// The element is not checked for duplicity. If the table is due to grow but
+/// the allocation of the new bucket array fails, the growth is postponed to
+/// the next insertion.
+///
+/// @param[in] hash  hash table
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+/// @param[in] hfunc hash function
+/// @param[in] elem  element
+#define HASH_INSERT(hash, type, link, hfunc, elem)                        \
+  do {                                                                    \
+    size_t _hash_b;                                                       \
+    void* _hash_n;                                                        \
+    _HASH_MIGRATE(hash, type, link, hfunc);                               \
+    _hash_b = _HASH_IDX(hash, 0, hfunc(elem));                            \
+    LIST_PUSH(&(hash)->_hash_tab[0][_hash_b], elem, link);                \
+    (hash)->_hash_cnt++;                                                  \
+    if ((hash)->_hash_cnt <= (hash)->_hash_cap[0]                         \
+        || (hash)->_hash_tab[1] != NULL)                                  \
+      break;                                                              \
+    _hash_n = calloc((hash)->_hash_cap[0] * 2,                            \
+                     sizeof(*(hash)->_hash_tab[0]));                      \
+    if (_hash_n == NULL)                                                  \
+      break;                                                              \
+    (hash)->_hash_tab[1] = (hash)->_hash_tab[0];                          \
+    (hash)->_hash_cap[1] = (hash)->_hash_cap[0];                          \
+    (hash)->_hash_tab[0] = _hash_n;                                       \
+    (hash)->_hash_cap[0] *= 2;                                            \
+    (hash)->_hash_mov = 0;                                                \
+  } while (0)
+
+/// Find an element that is equal to the key. The hash table is not modified.
+///
+/// @param[out] out   matching element or NULL
+/// @param[in]  hash  hash table
+/// @param[in]  type  element C type name
+/// @param[in]  link  element link name
+/// @param[in]  hfunc hash function
+/// @param[in]  efunc equality function
+/// @param[in]  key   key element
+#define HASH_FIND(out, hash, type, link, hfunc, efunc, key)                 \
+  do {                                                                      \
+    size_t _hash_h;                                                         \
+    size_t _hash_b;                                                         \
+    _hash_h = hfunc(key);                                                   \
+    _hash_b = _HASH_IDX(hash, 0, _hash_h);                                  \
+    LIST_FIND(out, &(hash)->_hash_tab[0][_hash_b], type, link, efunc, key); \
+    if (*(out) != NULL || (hash)->_hash_tab[1] == NULL)                     \
+      break;                                                                \
+    _hash_b = _HASH_IDX(hash, 1, _hash_h);                                  \
+    LIST_FIND(out, &(hash)->_hash_tab[1][_hash_b], type, link, efunc, key); \
+  } while (0)
+
+/// Remove the first element that is equal to the key.
+///
+/// @param[out] out   decision whether an element was removed
+/// @param[in]  hash  hash table
+/// @param[in]  type  element C type name
+/// @param[in]  link  element link name
+/// @param[in]  hfunc hash function
+/// @param[in]  efunc equality function
+/// @param[in]  key   key element
+/// @param[in]  clean deallocation function
+#define HASH_REMOVE(out, hash, type, link, hfunc, efunc, key, clean) \
+  do {                                                               \
+    size_t _hash_h;                                                  \
+    type** _hash_c;                                                  \
+    type* _hash_e;                                                   \
+    _HASH_MIGRATE(hash, type, link, hfunc);                          \
+    _hash_h = hfunc(key);                                            \
+    *(out) = false;                                                  \
+    for (int _hash_t = 0; _hash_t < 2 && !*(out); _hash_t++) {       \
+      if ((hash)->_hash_tab[_hash_t] == NULL)                        \
+        continue;                                                    \
+      _hash_c = &(hash)->_hash_tab[_hash_t]                          \
+                  [_HASH_IDX(hash, _hash_t, _hash_h)]._list_fst;     \
+      while (*_hash_c != NULL) {                                     \
+        _hash_e = *_hash_c;                                          \
+        if (efunc(_hash_e, key)) {                                   \
+          *_hash_c = _LIST_NXT(_hash_e, link);                       \
+          (hash)->_hash_cnt--;                                       \
+          if (clean != NULL)                                         \
+            clean(_hash_e);                                          \
+          *(out) = true;                                             \
+          break;                                                     \
+        }                                                            \
+        _hash_c = &(_LIST_NXT(_hash_e, link));                       \
+      }                                                              \
+    }                                                                \
+  } while (0)
+
+/// Traverse the hash table and execute a function for each element.
+/// The order of the traversal is unspecified.
+///
+/// @param[in] hash hash table
+/// @param[in] type element C type name
+/// @param[in] link element link name
+/// @param[in] func function
+/// @param[in] ...  variable-length arguments for the function
+#define HASH_MAP(hash, type, link, func, ...)                           \
+  do {                                                                  \
+    type* _hash_e;                                                      \
+    intmax_t _hash_i = 0;                                               \
+    for (int _hash_t = 0; _hash_t < 2; _hash_t++) {                     \
+      if ((hash)->_hash_tab[_hash_t] == NULL)                           \
+        continue;                                                       \
+      for (size_t _hash_b = 0;                                          \
+           _hash_b < (hash)->_hash_cap[_hash_t];                        \
+           _hash_b++) {                                                 \
+        _hash_e = (hash)->_hash_tab[_hash_t][_hash_b]._list_fst;        \
+        while (_hash_e != NULL) {                                       \
+          func(_hash_e, _hash_i, __VA_ARGS__);                          \
+          _hash_e = _LIST_NXT(_hash_e, link);                           \
+          _hash_i++;                                                    \
+        }                                                               \
+      }                                                                 \
+    }                                                                   \
+  } while (0)
+
+/// Obtain the number of elements in the hash table.
+///
+/// @param[out] out  number of elements
+/// @param[in]  hash hash table
+#define HASH_LENGTH(out, hash)    \
+  do {                            \
+    *(out) = (hash)->_hash_cnt;   \
+  } while (0)
+
+/// Remove all elements from the hash table and release the bucket arrays.
+///
+/// @param[in] hash  hash table
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+/// @param[in] clean deallocation function
+#define HASH_FREE(hash, type, link, clean)                                    \
+  do {                                                                        \
+    for (int _hash_t = 0; _hash_t < 2; _hash_t++) {                           \
+      if ((hash)->_hash_tab[_hash_t] == NULL)                                 \
+        continue;                                                             \
+      for (size_t _hash_b = 0;                                                \
+           _hash_b < (hash)->_hash_cap[_hash_t];                              \
+           _hash_b++)                                                         \
+        LIST_FREE(&(hash)->_hash_tab[_hash_t][_hash_b], type, link, clean);   \
+      free((hash)->_hash_tab[_hash_t]);                                       \
+      (hash)->_hash_tab[_hash_t] = NULL;                                      \
+    }                                                                         \
+    (hash)->_hash_cnt = 0;                                                    \
+  } while (0)
+#endif
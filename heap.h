@@ -0,0 +1,314 @@
+// Copyright (c) 2017-2019 Daniel Lovasko
+// All Rights Reserved
+//
+// Distributed under the terms of the 2-clause BSD License. The full
+// license is in the file LICENSE, distributed as part of this software.
+
+#ifndef HEAP_H
+#define HEAP_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "list.h"
+
+
+//////////////////////////////////////////
+// Function      // Time complexity     //
+//////////////////////////////////////////
+// HEAP_LINK     // compile time        //
+// HEAP_TYPE     // compile time        //
+// HEAP_NEW      // O(1)                //
+// HEAP_EMPTY    // O(1)                //
+// HEAP_MIN      // O(1)                //
+// HEAP_PUSH     // O(1)                //
+// HEAP_MELD     // O(1)                //
+// HEAP_POP      // O(log n) amortised  //
+// HEAP_DECREASE // O(log n) amortised  //
+// HEAP_REMOVE   // O(log n) amortised  //
+//////////////////////////////////////////
+
+// The heap is a pairing heap of elements ordered by a comparator with the
+// same signature as the one used by LIST_SORT, with the minimal element at
+// the root. The children of each element form a singly linked list through
+// the _list_nxt field, starting at the _heap_chd field of the parent. The
+// _heap_prv field points to the left sibling, or to the parent in case of
+// the first child, and allows an element to be cut out of the heap in O(1).
+
+/// Definition of a new heap element link.
+///
+/// @param[in] tag struct tag name
+#define HEAP_LINK(tag)     \
+  struct {                 \
+    struct tag* _list_nxt; \
+    struct tag* _heap_chd; \
+    struct tag* _heap_prv; \
+  }
+
+/// Definition of a new heap type.
+///
+/// @param[in] tag  struct tag name
+/// @param[in] type heap element type
+#define HEAP_TYPE(tag, type) \
+  struct tag {               \
+    type* _heap_root;        \
+  }
+
+/// Internal function to access the first child of an element.
+/// Please note that this function is for internal use only and should not be
+/// used in your code.
+/// @return NULL if the element has no children, first child otherwise
+///
+/// @param[in] elem element
+/// @param[in] link element link name
+#define _HEAP_CHD(elem, link) \
+  ((elem)->link._heap_chd)
+
+/// Internal function to access the left sibling or the parent of an element.
+/// Please note that this function is for internal use only and should not be
+/// used in your code.
+/// @return NULL if the element is the root, left sibling or parent otherwise
+///
+/// @param[in] elem element
+/// @param[in] link element link name
+#define _HEAP_PRV(elem, link) \
+  ((elem)->link._heap_prv)
+
+/// Internal function to access the root of the heap.
+/// Please note that this function is for internal use only and should not be
+/// used in your code.
+/// @return NULL if empty, root element otherwise
+///
+/// @param[in] heap heap
+#define _HEAP_ROOT(heap) \
+  ((heap)->_heap_root)
+
+/// Internal function to link two heap roots, making the greater one the first
+/// child of the lesser one.
+/// Please note that this function is for internal use only and should not be
+/// used in your code.
+///
+/// @param[out] out  new root
+/// @param[in]  a    first root
+/// @param[in]  b    second root
+/// @param[in]  type element C type name
+/// @param[in]  link element link name
+/// @param[in]  func comparator function
+/// @param[in]  ...  variable-length arguments for the comparator function
+#define _HEAP_MELD(out, a, b, type, link, func, ...)             \
+  do {                                                           \
+    type* _heap_mx = (a);                                        \
+    type* _heap_my = (b);                                        \
+    type* _heap_mt;                                              \
+    if (func(_heap_my, _heap_mx, __VA_ARGS__) < 0) {             \
+      _heap_mt = _heap_mx;                                       \
+      _heap_mx = _heap_my;                                       \
+      _heap_my = _heap_mt;                                       \
+    }                                                            \
+    _LIST_NXT(_heap_my, link) = _HEAP_CHD(_heap_mx, link);       \
+    if (_HEAP_CHD(_heap_mx, link) != NULL)                       \
+      _HEAP_PRV(_HEAP_CHD(_heap_mx, link), link) = _heap_my;     \
+    _HEAP_PRV(_heap_my, link) = _heap_mx;                        \
+    _HEAP_CHD(_heap_mx, link) = _heap_my;                        \
+    *(out) = _heap_mx;                                           \
+  } while (0)
+
+/// Internal function to combine a list of siblings into a single heap using
+/// the two-pass pairing method.
+/// Please note that this function is for internal use only and should not be
+/// used in your code.
+///
+/// @param[out] out  new root (NULL if there are no siblings)
+/// @param[in]  chd  first sibling
+/// @param[in]  type element C type name
+/// @param[in]  link element link name
+/// @param[in]  func comparator function
+/// @param[in]  ...  variable-length arguments for the comparator function
+#define _HEAP_COMBINE(out, chd, type, link, func, ...)                 \
+  do {                                                                 \
+    type* _heap_c = (chd);                                             \
+    type* _heap_p = NULL;                                              \
+    type* _heap_a;                                                     \
+    type* _heap_b;                                                     \
+    type* _heap_m;                                                     \
+    while (_heap_c != NULL) {                                          \
+      _heap_a = _heap_c;                                               \
+      _heap_b = _LIST_NXT(_heap_a, link);                              \
+      if (_heap_b == NULL) {                                           \
+        _heap_m = _heap_a;                                             \
+        _heap_c = NULL;                                                \
+      } else {                                                         \
+        _heap_c = _LIST_NXT(_heap_b, link);                            \
+        _HEAP_MELD(&_heap_m, _heap_a, _heap_b, type, link, func,       \
+                   __VA_ARGS__);                                       \
+      }                                                                \
+      _LIST_NXT(_heap_m, link) = _heap_p;                              \
+      _heap_p = _heap_m;                                               \
+    }                                                                  \
+    _heap_m = _heap_p;                                                 \
+    if (_heap_m != NULL) {                                             \
+      _heap_p = _LIST_NXT(_heap_m, link);                              \
+      while (_heap_p != NULL) {                                        \
+        _heap_c = _LIST_NXT(_heap_p, link);                            \
+        _HEAP_MELD(&_heap_m, _heap_m, _heap_p, type, link, func,       \
+                   __VA_ARGS__);                                       \
+        _heap_p = _heap_c;                                             \
+      }                                                                \
+      _LIST_NXT(_heap_m, link) = NULL;                                 \
+      _HEAP_PRV(_heap_m, link) = NULL;                                 \
+    }                                                                  \
+    *(out) = _heap_m;                                                  \
+  } while (0)
+
+/// Internal function to detach a non-root element, along with its children,
+/// from the heap.
+/// Please note that this function is for internal use only and should not be
+/// used in your code.
+///
+/// @param[in] elem element
+/// @param[in] link element link name
+#define _HEAP_CUT(elem, link)                                          \
+  do {                                                                 \
+    if (_HEAP_CHD(_HEAP_PRV(elem, link), link) == (elem))              \
+      _HEAP_CHD(_HEAP_PRV(elem, link), link) = _LIST_NXT(elem, link);  \
+    else                                                               \
+      _LIST_NXT(_HEAP_PRV(elem, link), link) = _LIST_NXT(elem, link);  \
+    if (_LIST_NXT(elem, link) != NULL)                                 \
+      _HEAP_PRV(_LIST_NXT(elem, link), link) = _HEAP_PRV(elem, link);  \
+    _LIST_NXT(elem, link) = NULL;                                      \
+    _HEAP_PRV(elem, link) = NULL;                                      \
+  } while (0)
+
+/// Initialise the heap.
+///
+/// @param[in] heap heap
+#define HEAP_NEW(heap)        \
+  do {                        \
+    _HEAP_ROOT(heap) = NULL;  \
+  } while (0)
+
+/// Determine whether the heap is empty.
+///
+/// @param[out] out  decision
+/// @param[in]  heap heap
+#define HEAP_EMPTY(out, heap)            \
+  do {                                   \
+    *(out) = (_HEAP_ROOT(heap) == NULL); \
+  } while (0)
+
+/// Obtain the minimal element of the heap.
+///
+/// @param[out] out  minimal element (NULL if the heap is empty)
+/// @param[in]  heap heap
+#define HEAP_MIN(out, heap)      \
+  do {                           \
+    *(out) = _HEAP_ROOT(heap);   \
+  } while (0)
+
+/// Insert an element to the heap.
+///
+/// @param[in] heap heap
+/// @param[in] type element C type name
+/// @param[in] link element link name
+/// @param[in] elem element
+/// @param[in] func comparator function
+/// @param[in] ...  variable-length arguments for the comparator function
+#define HEAP_PUSH(heap, type, link, elem, func, ...)                   \
+  do {                                                                 \
+    _LIST_NXT(elem, link) = NULL;                                      \
+    _HEAP_CHD(elem, link) = NULL;                                      \
+    _HEAP_PRV(elem, link) = NULL;                                      \
+    if (_HEAP_ROOT(heap) == NULL)                                      \
+      _HEAP_ROOT(heap) = (elem);                                       \
+    else                                                               \
+      _HEAP_MELD(&_HEAP_ROOT(heap), _HEAP_ROOT(heap), elem, type,      \
+                 link, func, __VA_ARGS__);                             \
+  } while (0)
+
+/// Move all elements from the second heap to the first one.
+///
+/// @param[in] heap1 first heap
+/// @param[in] heap2 second heap
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+/// @param[in] func  comparator function
+/// @param[in] ...   variable-length arguments for the comparator function
+#define HEAP_MELD(heap1, heap2, type, link, func, ...)                  \
+  do {                                                                  \
+    if (_HEAP_ROOT(heap2) == NULL)                                      \
+      break;                                                            \
+    if (_HEAP_ROOT(heap1) == NULL)                                      \
+      _HEAP_ROOT(heap1) = _HEAP_ROOT(heap2);                            \
+    else                                                                \
+      _HEAP_MELD(&_HEAP_ROOT(heap1), _HEAP_ROOT(heap1),                 \
+                 _HEAP_ROOT(heap2), type, link, func, __VA_ARGS__);     \
+    _HEAP_ROOT(heap2) = NULL;                                           \
+  } while (0)
+
+/// Remove the minimal element from the heap.
+///
+/// @param[in] heap  heap
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+/// @param[in] clean deallocation function
+/// @param[in] func  comparator function
+/// @param[in] ...   variable-length arguments for the comparator function
+#define HEAP_POP(heap, type, link, clean, func, ...)                     \
+  do {                                                                   \
+    type* _heap_e = _HEAP_ROOT(heap);                                    \
+    if (_heap_e == NULL)                                                 \
+      break;                                                             \
+    _HEAP_COMBINE(&_HEAP_ROOT(heap), _HEAP_CHD(_heap_e, link), type,     \
+                  link, func, __VA_ARGS__);                              \
+    _HEAP_CHD(_heap_e, link) = NULL;                                     \
+    if (clean != NULL)                                                   \
+      clean(_heap_e);                                                    \
+  } while (0)
+
+/// Restore the heap order after the key of an element has been decreased.
+///
+/// @param[in] heap heap
+/// @param[in] type element C type name
+/// @param[in] link element link name
+/// @param[in] elem element with the decreased key
+/// @param[in] func comparator function
+/// @param[in] ...  variable-length arguments for the comparator function
+#define HEAP_DECREASE(heap, type, link, elem, func, ...)                 \
+  do {                                                                   \
+    type* _heap_e = (elem);                                              \
+    if (_heap_e == _HEAP_ROOT(heap))                                     \
+      break;                                                             \
+    _HEAP_CUT(_heap_e, link);                                            \
+    _HEAP_MELD(&_HEAP_ROOT(heap), _HEAP_ROOT(heap), _heap_e, type,       \
+               link, func, __VA_ARGS__);                                 \
+  } while (0)
+
+/// Remove an arbitrary element from the heap.
+///
+/// @param[in] heap  heap
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+/// @param[in] elem  element
+/// @param[in] clean deallocation function
+/// @param[in] func  comparator function
+/// @param[in] ...   variable-length arguments for the comparator function
+#define HEAP_REMOVE(heap, type, link, elem, clean, func, ...)            \
+  do {                                                                   \
+    type* _heap_e = (elem);                                              \
+    type* _heap_s;                                                       \
+    if (_heap_e != _HEAP_ROOT(heap)) {                                   \
+      _HEAP_CUT(_heap_e, link);                                          \
+      _HEAP_COMBINE(&_heap_s, _HEAP_CHD(_heap_e, link), type, link,      \
+                    func, __VA_ARGS__);                                  \
+      if (_heap_s != NULL)                                               \
+        _HEAP_MELD(&_HEAP_ROOT(heap), _HEAP_ROOT(heap), _heap_s, type,   \
+                   link, func, __VA_ARGS__);                             \
+    } else {                                                             \
+      _HEAP_COMBINE(&_HEAP_ROOT(heap), _HEAP_CHD(_heap_e, link), type,   \
+                    link, func, __VA_ARGS__);                            \
+    }                                                                    \
+    _HEAP_CHD(_heap_e, link) = NULL;                                     \
+    if (clean != NULL)                                                   \
+      clean(_heap_e);                                                    \
+  } while (0)
+#endif
@@ -9,44 +9,66 @@
 
 #include <stdlib.h>
 #include <stdint.h>
+#include <stdbool.h>
 
 
-//////////////////////////////////////
-// Function      // Time complexity //
-//////////////////////////////////////
-// LIST_LINK    // compile time     //
-// LIST_TYPE    // compile time     //
-// LIST_FIRST   // O(1)             //
-// LIST_LAST    // O(n)             //
-// LIST_NTH     // O(n)             //
-// LIST_NEXT    // O(1)             //
-// LIST_NEW     // O(1)             //
-// LIST_EMPTY   // O(1)             //
-// LIST_MAP     // O(n)             //
-// LIST_FILTER  // O(n)             //
-// LIST_REVERSE // O(n)             //
-// LIST_FIND    // O(n)             //
-// LIST_PUSH    // O(1)             //
-// LIST_INSERT  // O(1)             //
-// LIST_POP     // O(1)             //
-// LIST_REMOVE  // O(1)             //
-// LIST_FREE    // O(n)             //
-// LIST_SORT    // O(n * log n)     //
-// LIST_UNIQUE  // O(n * n)         //
-// LIST_COPY    // O(1)             //
-// LIST_ATTACH  // O(1)             //
-// LIST_DETACH  // O(1)             //
-// LIST_DROP    // O(n)             //
-// LIST_TAKE    // O(n)             //
-// LIST_ALL     // O(n)             //
-// LIST_ANY     // O(n)             //
-// LIST_MAX     // O(n)             //
-// LIST_MIN     // O(n)             //
-// LIST_LENGTH  // O(n)             //
-// LIST_ZIP     // O(n)             //
-// LIST_MEMBER  // O(n)             //
-// LIST_APPEND  // O(n)             //
-//////////////////////////////////////
+//////////////////////////////////////////////////
+// Function                 // Time complexity  //
+//////////////////////////////////////////////////
+// LIST_LINK                // compile time     //
+// LIST_TYPE                // compile time     //
+// LIST_FIRST               // O(1)             //
+// LIST_LAST                // O(n)             //
+// LIST_NTH                 // O(n)             //
+// LIST_NEXT                // O(1)             //
+// LIST_NEW                 // O(1)             //
+// LIST_EMPTY               // O(1)             //
+// LIST_MAP                 // O(n)             //
+// LIST_FILTER              // O(n)             //
+// LIST_REVERSE             // O(n)             //
+// LIST_FIND                // O(n)             //
+// LIST_PUSH                // O(1)             //
+// LIST_INSERT              // O(1)             //
+// LIST_POP                 // O(1)             //
+// LIST_REMOVE              // O(1)             //
+// LIST_FREE                // O(n)             //
+// LIST_SORT                // O(n * log n)     //
+// LIST_SORT_STATE          // compile time     //
+// LIST_SORT_BEGIN          // O(1)             //
+// LIST_SORT_STEP           // O(budget)        //
+// LIST_SORT_END            // O(n * log n)     //
+// LIST_INSERT_SORTED       // O(n)             //
+// LIST_INSERT_SORTED_BATCH // O(n + m * log m) //
+// LIST_UNIQUE              // O(n * n)         //
+// LIST_COPY                // O(1)             //
+// LIST_ATTACH              // O(1)             //
+// LIST_DETACH              // O(1)             //
+// LIST_DROP                // O(n)             //
+// LIST_TAKE                // O(n)             //
+// LIST_ALL                 // O(n)             //
+// LIST_ANY                 // O(n)             //
+// LIST_MAX                 // O(n)             //
+// LIST_MIN                 // O(n)             //
+// LIST_LENGTH              // O(n)             //
+// LIST_ZIP                 // O(n)             //
+// LIST_MEMBER              // O(n)             //
+// LIST_APPEND              // O(n)             //
+// LIST_COMPACT             // O(n)             //
+// LIST_COMPACT_FREE        // O(n)             //
+// LIST_INDEX_TYPE          // compile time     //
+// LIST_INDEX_NEW           // O(1)             //
+// LIST_INDEX_BUILD         // O(n)             //
+// LIST_INDEX_NTH           // O(k)             //
+// LIST_INDEX_DROP          // O(n)             //
+// LIST_INDEX_TAKE          // O(n)             //
+// LIST_INDEX_FREE          // O(1)             //
+// LIST_GENERATE            // compile time     //
+//////////////////////////////////////////////////
+
+/// Size of the cache line that the compacted elements are aligned to.
+#ifndef LIST_CACHE_LINE
+  #define LIST_CACHE_LINE 64
+#endif
 
 /// Definition of a new element link.
 ///
@@ -371,6 +393,195 @@
     _LIST_FST(list) = _list_x;                                      \
   } while (0)
 
+/// Definition of a new incremental sort state type.
+///
+/// @param[in] tag  struct tag name
+/// @param[in] type list element type
+#define LIST_SORT_STATE(tag, type)                    \
+  struct tag {                                        \
+    type *_list_l, *_list_r, *_list_t, *_list_x;      \
+    intmax_t _list_gl, _list_nm, _list_ls, _list_rs;  \
+    int _list_ph;                                     \
+  }
+
+/// Start sorting the elements of the list incrementally.
+///
+/// The elements are detached from the list and held by the state until they
+/// are attached back by LIST_SORT_END. The state occupies O(1) space.
+///
+/// @param[in] state sort state
+/// @param[in] list  list
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+#define LIST_SORT_BEGIN(state, list, type, link)                       \
+  do {                                                                 \
+    (state)->_list_l = NULL;                                           \
+    (state)->_list_r = NULL;                                           \
+    (state)->_list_t = NULL;                                           \
+    (state)->_list_x = _LIST_FST(list);                                \
+    (state)->_list_gl = 1;                                             \
+    (state)->_list_nm = 0;                                             \
+    (state)->_list_ls = 0;                                             \
+    (state)->_list_rs = 0;                                             \
+    (state)->_list_ph = 1;                                             \
+    if ((state)->_list_x == NULL                                       \
+        || _LIST_NXT((state)->_list_x, link) == NULL)                  \
+      (state)->_list_ph = 0;                                           \
+    _LIST_FST(list) = NULL;                                            \
+  } while (0)
+
+/// Perform a bounded amount of sorting work.
+///
+/// The algorithm is the same bottom-up merge-sort as in LIST_SORT, suspended
+/// after the budget of visited elements is exhausted. The sorting is finished
+/// once the decision is true.
+///
+/// @param[out] out    decision whether the sorting is finished
+/// @param[in]  state  sort state
+/// @param[in]  type   element C type name
+/// @param[in]  link   element link name
+/// @param[in]  budget maximal number of elements to visit (at least one)
+/// @param[in]  func   comparator function
+/// @param[in]  ...    variable-length arguments for the comparator function
+#define LIST_SORT_STEP(out, state, type, link, budget, func, ...)           \
+  do {                                                                      \
+    intmax_t _list_b = (intmax_t)(budget) > 0 ? (intmax_t)(budget) : 1;     \
+    type* _list_n;                                                          \
+    while (_list_b > 0 && (state)->_list_ph != 0) {                         \
+      if ((state)->_list_ph == 1) {                                         \
+        (state)->_list_nm = 0;                                              \
+        (state)->_list_l = (state)->_list_x;                                \
+        (state)->_list_t = NULL;                                            \
+        (state)->_list_x = NULL;                                            \
+        (state)->_list_ph = 2;                                              \
+      } else if ((state)->_list_ph == 2) {                                  \
+        if ((state)->_list_l == NULL) {                                     \
+          _LIST_NXT((state)->_list_t, link) = NULL;                         \
+          (state)->_list_gl *= 2;                                           \
+          (state)->_list_ph = (state)->_list_nm > 1 ? 1 : 0;                \
+        } else {                                                            \
+          (state)->_list_nm += 1;                                           \
+          (state)->_list_r = (state)->_list_l;                              \
+          (state)->_list_ls = 0;                                            \
+          (state)->_list_rs = (state)->_list_gl;                            \
+          (state)->_list_ph = 3;                                            \
+        }                                                                   \
+      } else if ((state)->_list_ph == 3) {                                  \
+        if ((state)->_list_r != NULL                                        \
+            && (state)->_list_ls < (state)->_list_gl) {                     \
+          (state)->_list_ls += 1;                                           \
+          (state)->_list_r = _LIST_NXT((state)->_list_r, link);             \
+          _list_b--;                                                        \
+        } else {                                                            \
+          (state)->_list_ph = 4;                                            \
+        }                                                                   \
+      } else if ((state)->_list_ls > 0                                      \
+                 || ((state)->_list_rs > 0 && (state)->_list_r != NULL)) {  \
+        if ((state)->_list_ls == 0) {                                       \
+          _list_n = (state)->_list_r;                                       \
+          (state)->_list_r = _LIST_NXT((state)->_list_r, link);             \
+          (state)->_list_rs -= 1;                                           \
+        } else if ((state)->_list_rs == 0 || (state)->_list_r == NULL       \
+            || func((state)->_list_l, (state)->_list_r, __VA_ARGS__) < 0) { \
+          _list_n = (state)->_list_l;                                       \
+          (state)->_list_l = _LIST_NXT((state)->_list_l, link);             \
+          (state)->_list_ls -= 1;                                           \
+        } else {                                                            \
+          _list_n = (state)->_list_r;                                       \
+          (state)->_list_r = _LIST_NXT((state)->_list_r, link);             \
+          (state)->_list_rs -= 1;                                           \
+        }                                                                   \
+        if ((state)->_list_t != NULL)                                       \
+          _LIST_NXT((state)->_list_t, link) = _list_n;                      \
+        else                                                                \
+          (state)->_list_x = _list_n;                                       \
+        (state)->_list_t = _list_n;                                         \
+        _list_b--;                                                          \
+      } else {                                                              \
+        (state)->_list_l = (state)->_list_r;                                \
+        (state)->_list_ph = 2;                                              \
+      }                                                                     \
+    }                                                                       \
+    *(out) = ((state)->_list_ph == 0);                                      \
+  } while (0)
+
+/// Attach the sorted elements back to the list. If the sorting was not
+/// finished by LIST_SORT_STEP yet, the remaining work is performed first.
+///
+/// @param[in] state sort state
+/// @param[in] list  list
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+/// @param[in] func  comparator function
+/// @param[in] ...   variable-length arguments for the comparator function
+#define LIST_SORT_END(state, list, type, link, func, ...)                   \
+  do {                                                                      \
+    bool _list_d;                                                           \
+    LIST_SORT_STEP(&_list_d, state, type, link, INTMAX_MAX,                 \
+                   func, __VA_ARGS__);                                      \
+    _LIST_FST(list) = (state)->_list_x;                                     \
+  } while (0)
+
+/// Insert an element into the sorted list, keeping the list sorted. The
+/// element is inserted after all elements that compare equal to it.
+///
+/// The search starts from the hint instead of the head of the list, provided
+/// that the hint does not compare greater than the element. The hint is then
+/// set to the inserted element, and therefore inserting the elements in an
+/// ascending order takes O(1) amortised time per element. The hint must either
+/// be NULL or point to an element of the list.
+///
+/// @param[in] list list
+/// @param[in] type element C type name
+/// @param[in] link element link name
+/// @param[in] hint pointer to the previously inserted element
+/// @param[in] elem element
+/// @param[in] func comparator function
+/// @param[in] ...  variable-length arguments for the comparator function
+#define LIST_INSERT_SORTED(list, type, link, hint, elem, func, ...)    \
+  do {                                                                 \
+    type** _list_p = &_LIST_FST(list);                                 \
+    if (*(hint) != NULL && func(*(hint), elem, __VA_ARGS__) <= 0)      \
+      _list_p = &_LIST_NXT(*(hint), link);                             \
+    while (*_list_p != NULL && func(*_list_p, elem, __VA_ARGS__) <= 0) \
+      _list_p = &_LIST_NXT(*_list_p, link);                            \
+    _LIST_NXT(elem, link) = *_list_p;                                  \
+    *_list_p = (elem);                                                 \
+    *(hint) = (elem);                                                  \
+  } while (0)
+
+/// Insert all elements of the batch list into the sorted list, keeping the
+/// list sorted. The batch is sorted first and then merged into the list in a
+/// single pass, so that inserting m elements into a list of n elements takes
+/// O(n + m * log m) time. Elements of the batch are inserted after all
+/// elements of the list that compare equal to them. The batch list is empty
+/// afterwards.
+///
+/// @param[in] list  list
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+/// @param[in] batch batch list
+/// @param[in] func  comparator function
+/// @param[in] ...   variable-length arguments for the comparator function
+#define LIST_INSERT_SORTED_BATCH(list, type, link, batch, func, ...)        \
+  do {                                                                      \
+    type** _list_p = &_LIST_FST(list);                                      \
+    type* _list_b;                                                          \
+    type* _list_n;                                                          \
+    LIST_SORT(batch, type, link, func, __VA_ARGS__);                        \
+    _list_b = _LIST_FST(batch);                                             \
+    while (_list_b != NULL) {                                               \
+      while (*_list_p != NULL && func(*_list_p, _list_b, __VA_ARGS__) <= 0) \
+        _list_p = &_LIST_NXT(*_list_p, link);                               \
+      _list_n = _LIST_NXT(_list_b, link);                                   \
+      _LIST_NXT(_list_b, link) = *_list_p;                                  \
+      *_list_p = _list_b;                                                   \
+      _list_p = &_LIST_NXT(_list_b, link);                                  \
+      _list_b = _list_n;                                                    \
+    }                                                                       \
+    _LIST_FST(batch) = NULL;                                                \
+  } while (0)
+
 /// Remove duplicate elements from the list.
 /// This function does not reorder the elements.
 ///
@@ -388,7 +599,8 @@
       while (_LIST_NXT(_list_g, link) != NULL) {                       \
         if (func(_list_f, _LIST_NXT(_list_g, link), __VA_ARGS__) == 0) \
           LIST_REMOVE(_list_g, type, link, clean);                     \
-        _list_g = _LIST_NXT(_list_g, link);                            \
+        else                                                           \
+          _list_g = _LIST_NXT(_list_g, link);                          \
       }                                                                \
       _list_f = _LIST_NXT(_list_f, link);                              \
     }                                                                  \
@@ -611,4 +823,422 @@
     else                                      \
       _LIST_NXT(_list_f, link) = _list_g;     \
   } while (0)
+
+/// Memory block holding compacted elements.
+struct list_block {
+  void*    lb_mem; ///< start of the allocation, to be released by free(3)
+  intmax_t lb_cnt; ///< number of elements in the block
+};
+
+/// Internal function to align an address to the cache line size. Please note
+/// that this function is for internal use only and should not be used in your
+/// code.
+/// @return aligned address
+///
+/// @param[in] addr address
+#define _LIST_ALIGN(addr)                    \
+  (((uintptr_t)(addr) + LIST_CACHE_LINE - 1) \
+   & ~(uintptr_t)(LIST_CACHE_LINE - 1))
+
+/// Internal function to determine whether an element is stored in a block of
+/// compacted elements. Please note that this function is for internal use only
+/// and should not be used in your code.
+/// @return decision
+///
+/// @param[in] block memory block
+/// @param[in] type  element C type name
+/// @param[in] elem  element
+#define _LIST_IN_BLOCK(block, type, elem)               \
+  ((block)->lb_mem != NULL                              \
+   && (uintptr_t)(elem) >= _LIST_ALIGN((block)->lb_mem) \
+   && (uintptr_t)(elem) < _LIST_ALIGN((block)->lb_mem)  \
+                          + (uintptr_t)(block)->lb_cnt * sizeof(type))
+
+/// Relocate all elements of the list into a single contiguous memory block.
+///
+/// The elements are copied in their current order into one cache-line-aligned
+/// block, so that subsequent traversals access memory sequentially. The fixup
+/// function is called with the new and the old location of each element before
+/// the old element is released, allowing the caller to update any external
+/// pointers.
+///
+/// The block argument describes the block produced by the previous compaction
+/// of the list, and must be zero-initialised before the first one. Elements
+/// that reside in the previous block are not passed to the deallocation
+/// function; instead, the whole previous block is released once all elements
+/// were relocated, and the block argument is updated to describe the new
+/// block. The list can therefore be compacted repeatedly, with new elements
+/// added in between. Relocated elements must not be released individually:
+/// remove them with a no-op deallocation function, and release the remaining
+/// elements together with the block by LIST_COMPACT_FREE. If the allocation
+/// fails, the output is set to false and both the list and the block are left
+/// intact.
+///
+/// @param[out] out   success/failure
+/// @param[in]  block memory block of the previous compaction
+/// @param[in]  list  list
+/// @param[in]  type  element C type name
+/// @param[in]  link  element link name
+/// @param[in]  clean deallocation function for the old elements
+/// @param[in]  func  fixup function
+/// @param[in]  ...   variable-length arguments for the fixup function
+#define LIST_COMPACT(out, block, list, type, link, clean, func, ...) \
+  do {                                                               \
+    type* _list_e;                                                   \
+    type* _list_n;                                                   \
+    type* _list_a;                                                   \
+    void* _list_m = NULL;                                            \
+    intmax_t _list_i;                                                \
+    intmax_t _list_c;                                                \
+    LIST_LENGTH(&_list_c, list, type, link);                         \
+    if (_list_c > 0) {                                               \
+      _list_m = malloc((size_t)_list_c * sizeof(type)                \
+                       + LIST_CACHE_LINE - 1);                       \
+      if (_list_m == NULL) {                                         \
+        *(out) = false;                                              \
+        break;                                                       \
+      }                                                              \
+    }                                                                \
+    _list_a = (type*)_LIST_ALIGN(_list_m);                           \
+    _list_e = _LIST_FST(list);                                       \
+    for (_list_i = 0; _list_i < _list_c; _list_i++) {                \
+      _list_n = _LIST_NXT(_list_e, link);                            \
+      _list_a[_list_i] = *_list_e;                                   \
+      _LIST_NXT(&_list_a[_list_i], link) =                           \
+        _list_i + 1 < _list_c ? &_list_a[_list_i + 1] : NULL;        \
+      func(&_list_a[_list_i], _list_e, __VA_ARGS__);                 \
+      if (!_LIST_IN_BLOCK(block, type, _list_e))                     \
+        clean(_list_e);                                              \
+      _list_e = _list_n;                                             \
+    }                                                                \
+    _LIST_FST(list) = _list_c > 0 ? _list_a : NULL;                  \
+    free((block)->lb_mem);                                           \
+    (block)->lb_mem = _list_m;                                       \
+    (block)->lb_cnt = _list_c;                                       \
+    *(out) = true;                                                   \
+  } while (0)
+
+/// Remove all elements from a compacted list and release its memory block.
+/// Elements that do not reside in the block are passed to the deallocation
+/// function.
+///
+/// @param[in] block memory block of the last compaction
+/// @param[in] list  list
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+/// @param[in] clean deallocation function
+#define LIST_COMPACT_FREE(block, list, type, link, clean) \
+  do {                                                    \
+    type* _list_e = _LIST_FST(list);                      \
+    type* _list_n;                                        \
+    while (_list_e != NULL) {                             \
+      _list_n = _LIST_NXT(_list_e, link);                 \
+      if (!_LIST_IN_BLOCK(block, type, _list_e))          \
+        clean(_list_e);                                   \
+      _list_e = _list_n;                                  \
+    }                                                     \
+    _LIST_FST(list) = NULL;                               \
+    free((block)->lb_mem);                                \
+    (block)->lb_mem = NULL;                               \
+    (block)->lb_cnt = 0;                                  \
+  } while (0)
+
+/// Definition of a new positional index type.
+///
+/// The index stores a pointer to every k-th element of a list, so that an
+/// element at a given position can be reached by walking at most k - 1 links
+/// from the nearest preceding checkpoint. The index is built lazily by the
+/// first query. Any modification of the list that is not performed through
+/// the LIST_INDEX_* macros must be followed by LIST_INDEX_INVALIDATE.
+///
+/// @param[in] tag  struct tag name
+/// @param[in] type list element type
+#define LIST_INDEX_TYPE(tag, type) \
+  struct tag {                     \
+    type**   _list_chk;            \
+    intmax_t _list_ncp;            \
+    intmax_t _list_cap;            \
+    intmax_t _list_stp;            \
+  }
+
+/// Initialise the positional index.
+///
+/// @param[in] index positional index
+/// @param[in] k     distance between two checkpoints
+#define LIST_INDEX_NEW(index, k)                                \
+  do {                                                          \
+    (index)->_list_chk = NULL;                                  \
+    (index)->_list_ncp = -1;                                    \
+    (index)->_list_cap = 0;                                     \
+    (index)->_list_stp = (intmax_t)(k) > 0 ? (intmax_t)(k) : 1; \
+  } while (0)
+
+/// Mark the positional index as stale, causing it to be rebuilt by the next
+/// query.
+///
+/// @param[in] index positional index
+#define LIST_INDEX_INVALIDATE(index) \
+  do {                               \
+    (index)->_list_ncp = -1;         \
+  } while (0)
+
+/// Release all resources held by the positional index. The index retains the
+/// distance between two checkpoints and can be used again.
+///
+/// @param[in] index positional index
+#define LIST_INDEX_FREE(index)   \
+  do {                           \
+    free((index)->_list_chk);    \
+    (index)->_list_chk = NULL;   \
+    (index)->_list_ncp = -1;     \
+    (index)->_list_cap = 0;      \
+  } while (0)
+
+/// Build the positional index of the list.
+///
+/// @param[out] out   success/failure
+/// @param[in]  index positional index
+/// @param[in]  list  list
+/// @param[in]  type  element C type name
+/// @param[in]  link  element link name
+#define LIST_INDEX_BUILD(out, index, list, type, link)            \
+  do {                                                            \
+    type** _list_t;                                               \
+    intmax_t _list_i = 0;                                         \
+    *(out) = true;                                                \
+    (index)->_list_ncp = 0;                                       \
+    for (type* _list_e = _LIST_FST(list);                         \
+         _list_e != NULL;                                         \
+         _list_e = _LIST_NXT(_list_e, link), _list_i++) {         \
+      if (_list_i % (index)->_list_stp != 0)                      \
+        continue;                                                 \
+      if ((index)->_list_ncp == (index)->_list_cap) {             \
+        _list_t = realloc((index)->_list_chk,                     \
+          (size_t)((index)->_list_cap * 2 + 16) * sizeof(type*)); \
+        if (_list_t == NULL) {                                    \
+          (index)->_list_ncp = -1;                                \
+          *(out) = false;                                         \
+          break;                                                  \
+        }                                                         \
+        (index)->_list_chk = _list_t;                             \
+        (index)->_list_cap = (index)->_list_cap * 2 + 16;         \
+      }                                                           \
+      (index)->_list_chk[(index)->_list_ncp++] = _list_e;         \
+    }                                                             \
+  } while (0)
+
+/// Obtain the n-th element of the list using the positional index.
+///
+/// @param[out] out   n-th element (NULL if the list is shorter)
+/// @param[in]  index positional index
+/// @param[in]  list  list
+/// @param[in]  type  element C type name
+/// @param[in]  link  element link name
+/// @param[in]  n     position of the element
+#define LIST_INDEX_NTH(out, index, list, type, link, n)    \
+  do {                                                     \
+    bool _list_b;                                          \
+    intmax_t _list_n = (n) > 0 ? (intmax_t)(n) : 0;        \
+    intmax_t _list_c;                                      \
+    type* _list_e;                                         \
+    if ((index)->_list_ncp < 0)                            \
+      LIST_INDEX_BUILD(&_list_b, index, list, type, link); \
+    if ((index)->_list_ncp < 0) {                          \
+      LIST_NTH(out, list, type, link, _list_n);            \
+      break;                                               \
+    }                                                      \
+    if ((index)->_list_ncp == 0) {                         \
+      *(out) = NULL;                                       \
+      break;                                               \
+    }                                                      \
+    _list_c = _list_n / (index)->_list_stp;                \
+    if (_list_c >= (index)->_list_ncp)                     \
+      _list_c = (index)->_list_ncp - 1;                    \
+    _list_e = (index)->_list_chk[_list_c];                 \
+    _list_n -= _list_c * (index)->_list_stp;               \
+    while (_list_n > 0 && _list_e != NULL) {               \
+      _list_e = _LIST_NXT(_list_e, link);                  \
+      _list_n--;                                           \
+    }                                                      \
+    *(out) = _list_e;                                      \
+  } while (0)
+
+/// Drop the first N elements from the list and update the positional index.
+///
+/// @param[in] index positional index
+/// @param[in] list  list
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+/// @param[in] n     number of elements to drop
+/// @param[in] clean deallocation function
+#define LIST_INDEX_DROP(index, list, type, link, n, clean)                 \
+  do {                                                                     \
+    intmax_t _list_d = (n) > 0 ? (intmax_t)(n) : 0;                        \
+    intmax_t _list_s;                                                      \
+    LIST_DROP(list, type, link, _list_d, clean);                           \
+    if ((index)->_list_ncp < 0)                                            \
+      break;                                                               \
+    if (_list_d % (index)->_list_stp != 0) {                               \
+      (index)->_list_ncp = -1;                                             \
+      break;                                                               \
+    }                                                                      \
+    _list_s = _list_d / (index)->_list_stp;                                \
+    if (_list_s > (index)->_list_ncp)                                      \
+      _list_s = (index)->_list_ncp;                                        \
+    (index)->_list_ncp -= _list_s;                                         \
+    for (intmax_t _list_i = 0; _list_i < (index)->_list_ncp; _list_i++)    \
+      (index)->_list_chk[_list_i] = (index)->_list_chk[_list_i + _list_s]; \
+  } while (0)
+
+/// Take the first N elements from the list, dispose of the rest and update
+/// the positional index.
+///
+/// @param[in] index positional index
+/// @param[in] list  list
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+/// @param[in] n     number of elements to take
+/// @param[in] clean deallocation function
+#define LIST_INDEX_TAKE(index, list, type, link, n, clean)             \
+  do {                                                                 \
+    intmax_t _list_t = (intmax_t)(n);                                  \
+    intmax_t _list_k;                                                  \
+    type* _list_f;                                                     \
+    if (_list_t <= 0) {                                                \
+      LIST_FREE(list, type, link, clean);                              \
+      if ((index)->_list_ncp > 0)                                      \
+        (index)->_list_ncp = 0;                                        \
+      break;                                                           \
+    }                                                                  \
+    LIST_INDEX_NTH(&_list_f, index, list, type, link, _list_t - 1);    \
+    if (_list_f == NULL)                                               \
+      break;                                                           \
+    while (_LIST_NXT(_list_f, link) != NULL)                           \
+      LIST_REMOVE(_list_f, type, link, clean);                         \
+    _list_k = (_list_t + (index)->_list_stp - 1) / (index)->_list_stp; \
+    if ((index)->_list_ncp > _list_k)                                  \
+      (index)->_list_ncp = _list_k;                                    \
+  } while (0)
+
+/// Define type-specialised functions for a list type.
+///
+/// The macros above are expanded at each call site. This macro instead
+/// defines a set of static inline functions for a particular list type once,
+/// with the comparator bound at compile time. The comparator has the same
+/// signature as for LIST_SORT and receives the payload argument of each
+/// function. The deallocation function has the signature of free(3), and
+/// the predicate has the same signature as for LIST_FILTER.
+///
+/// The following functions are defined:
+///  - void  prefix_sort(list* l, void* arg)
+///  - void  prefix_insert_sorted(list* l, type** hint, type* elem, void* arg)
+///  - void  prefix_insert_sorted_batch(list* l, list* batch, void* arg)
+///  - void  prefix_unique(list* l, void (*clean)(void*), void* arg)
+///  - void  prefix_filter(list* l, void (*clean)(void*),
+///                        bool (*pred)(const type*, intmax_t, void*),
+///                        void* arg)
+///  - void  prefix_reverse(list* l)
+///  - type* prefix_find(const list* l, const type* key, void* arg)
+///  - type* prefix_min(const list* l, void* arg)
+///  - type* prefix_max(const list* l, void* arg)
+///  - bool  prefix_member(const list* l, const type* elem)
+///  - intmax_t prefix_length(const list* l)
+///
+/// @param[in] prefix function name prefix
+/// @param[in] ltype  list C type name
+/// @param[in] type   element C type name
+/// @param[in] link   element link name
+/// @param[in] cmp    comparator function
+#define LIST_GENERATE(prefix, ltype, type, link, cmp)                        \
+  static inline void                                                         \
+  prefix##_sort(ltype* _lgen_l, void* _lgen_a)                               \
+  {                                                                          \
+    LIST_SORT(_lgen_l, type, link, cmp, _lgen_a);                            \
+  }                                                                          \
+                                                                             \
+  static inline void                                                         \
+  prefix##_insert_sorted(ltype* _lgen_l,                                     \
+                         type** _lgen_h,                                     \
+                         type* _lgen_e,                                      \
+                         void* _lgen_a)                                      \
+  {                                                                          \
+    LIST_INSERT_SORTED(_lgen_l, type, link, _lgen_h, _lgen_e, cmp, _lgen_a); \
+  }                                                                          \
+                                                                             \
+  static inline void                                                         \
+  prefix##_insert_sorted_batch(ltype* _lgen_l,                               \
+                               ltype* _lgen_b,                               \
+                               void* _lgen_a)                                \
+  {                                                                          \
+    LIST_INSERT_SORTED_BATCH(_lgen_l, type, link, _lgen_b, cmp, _lgen_a);    \
+  }                                                                          \
+                                                                             \
+  static inline void                                                         \
+  prefix##_unique(ltype* _lgen_l, void (*_lgen_c)(void*), void* _lgen_a)     \
+  {                                                                          \
+    LIST_UNIQUE(_lgen_l, type, link, _lgen_c, cmp, _lgen_a);                 \
+  }                                                                          \
+                                                                             \
+  static inline void                                                         \
+  prefix##_filter(ltype* _lgen_l,                                            \
+                  void (*_lgen_c)(void*),                                    \
+                  bool (*_lgen_p)(const type*, intmax_t, void*),             \
+                  void* _lgen_a)                                             \
+  {                                                                          \
+    LIST_FILTER(_lgen_l, type, link, _lgen_c, _lgen_p, _lgen_a);             \
+  }                                                                          \
+                                                                             \
+  static inline void                                                         \
+  prefix##_reverse(ltype* _lgen_l)                                           \
+  {                                                                          \
+    LIST_REVERSE(_lgen_l, type, link);                                       \
+  }                                                                          \
+                                                                             \
+  static inline type*                                                        \
+  prefix##_find(const ltype* _lgen_l, const type* _lgen_k, void* _lgen_a)    \
+  {                                                                          \
+    for (type* _lgen_x = _LIST_FST(_lgen_l);                                 \
+         _lgen_x != NULL;                                                    \
+         _lgen_x = _LIST_NXT(_lgen_x, link))                                 \
+      if (cmp(_lgen_x, _lgen_k, _lgen_a) == 0)                               \
+        return _lgen_x;                                                      \
+                                                                             \
+    return NULL;                                                             \
+  }                                                                          \
+                                                                             \
+  static inline type*                                                        \
+  prefix##_min(const ltype* _lgen_l, void* _lgen_a)                          \
+  {                                                                          \
+    type* _lgen_x;                                                           \
+                                                                             \
+    LIST_MIN(&_lgen_x, _lgen_l, type, link, cmp, _lgen_a);                   \
+    return _lgen_x;                                                          \
+  }                                                                          \
+                                                                             \
+  static inline type*                                                        \
+  prefix##_max(const ltype* _lgen_l, void* _lgen_a)                          \
+  {                                                                          \
+    type* _lgen_x;                                                           \
+                                                                             \
+    LIST_MAX(&_lgen_x, _lgen_l, type, link, cmp, _lgen_a);                   \
+    return _lgen_x;                                                          \
+  }                                                                          \
+                                                                             \
+  static inline bool                                                         \
+  prefix##_member(const ltype* _lgen_l, const type* _lgen_e)                 \
+  {                                                                          \
+    bool _lgen_r;                                                            \
+                                                                             \
+    LIST_MEMBER(&_lgen_r, _lgen_l, type, link, _lgen_e);                     \
+    return _lgen_r;                                                          \
+  }                                                                          \
+                                                                             \
+  static inline intmax_t                                                     \
+  prefix##_length(const ltype* _lgen_l)                                      \
+  {                                                                          \
+    intmax_t _lgen_n;                                                        \
+                                                                             \
+    LIST_LENGTH(&_lgen_n, _lgen_l, type, link);                              \
+    return _lgen_n;                                                          \
+  }
 #endif
@@ -0,0 +1,201 @@
+// Copyright (c) 2017-2019 Daniel Lovasko
+// All Rights Reserved
+//
+// Distributed under the terms of the 2-clause BSD License. The full
+// license is in the file LICENSE, distributed as part of this software.
+
+#ifndef LIST_BLOOM_H
+#define LIST_BLOOM_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "list.h"
+
+
+///////////////////////////////////////////
+// Function           // Time complexity //
+///////////////////////////////////////////
+// LIST_BLOOM_TYPE    // compile time    //
+// LIST_BLOOM_NEW     // O(m)            //
+// LIST_BLOOM_ADD     // O(1)            //
+// LIST_BLOOM_TEST    // O(1)            //
+// LIST_BLOOM_CLEAR   // O(m)            //
+// LIST_BLOOM_REBUILD // O(m + n)        //
+// LIST_BLOOM_MEMBER  // O(1) or O(n)    //
+// LIST_BLOOM_FIND    // O(1) or O(n)    //
+// LIST_BLOOM_FREE    // O(1)            //
+///////////////////////////////////////////
+
+// The membership filter is a blocked Bloom filter that accompanies a list and
+// answers whether a key is definitely absent from it. The filter consists of m
+// 64-bit blocks, and each key sets LIST_BLOOM_HASHES bits within a single block
+// selected by its hash, so that both adding and testing a key touch exactly one
+// word of memory. Definite misses are therefore answered in O(1) without
+// accessing any element of the list, whereas possible hits fall back to the
+// linear search.
+//
+// Keys are 64-bit hash values supplied by the caller, and are further mixed by
+// the filter, so that even weak hashes (e.g. element addresses obtained with
+// LIST_BLOOM_ADDR) are distributed evenly. The filter is not updated by the
+// list macros: elements must be registered with LIST_BLOOM_ADD as they are
+// inserted to the list. Removed elements cannot be unregistered, which only
+// increases the rate of false positives, and the filter can be periodically
+// brought up to date with LIST_BLOOM_REBUILD.
+
+/// Number of bits set for each key.
+#ifndef LIST_BLOOM_HASHES
+  #define LIST_BLOOM_HASHES 4
+#endif
+
+/// Number of filter bits allocated for each expected element.
+#ifndef LIST_BLOOM_BITS
+  #define LIST_BLOOM_BITS 12
+#endif
+
+/// Key of an element identified by its address.
+///
+/// @param[in] elem element
+#define LIST_BLOOM_ADDR(elem) ((uint64_t)(uintptr_t)(elem))
+
+/// Definition of a new membership filter type.
+///
+/// @param[in] tag struct tag name
+#define LIST_BLOOM_TYPE(tag)  \
+  struct tag {                \
+    uint64_t* _list_blk;      \
+    size_t    _list_nbk;      \
+  }
+
+/// Internal function to select the block and bits of a key. Please note that
+/// this function is for internal use only and should not be used in your code.
+///
+/// @param[out] blk   block index
+/// @param[out] msk   bit mask
+/// @param[in]  bloom membership filter
+/// @param[in]  key   key hash
+#define _LIST_BLOOM_BITS(blk, msk, bloom, key)                              \
+  do {                                                                      \
+    uint64_t _list_h = (uint64_t)(key);                                     \
+    _list_h = (_list_h ^ (_list_h >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);   \
+    _list_h = (_list_h ^ (_list_h >> 27)) * UINT64_C(0x94d049bb133111eb);   \
+    _list_h = _list_h ^ (_list_h >> 31);                                    \
+    *(blk) = (size_t)(_list_h >> 32) & ((bloom)->_list_nbk - 1);            \
+    *(msk) = 0;                                                             \
+    for (int _list_k = 0; _list_k < LIST_BLOOM_HASHES; _list_k++)           \
+      *(msk) |= UINT64_C(1) << ((_list_h >> (6 * _list_k)) & 63);           \
+  } while (0)
+
+/// Initialise the membership filter.
+///
+/// @param[out] out   success/failure
+/// @param[in]  bloom membership filter
+/// @param[in]  n     expected number of elements
+#define LIST_BLOOM_NEW(out, bloom, n)                                       \
+  do {                                                                      \
+    size_t _list_w = ((size_t)(n) * LIST_BLOOM_BITS + 63) / 64;             \
+    (bloom)->_list_nbk = 1;                                                 \
+    while ((bloom)->_list_nbk < _list_w)                                    \
+      (bloom)->_list_nbk *= 2;                                              \
+    (bloom)->_list_blk = calloc((bloom)->_list_nbk, sizeof(uint64_t));      \
+    *(out) = ((bloom)->_list_blk != NULL);                                  \
+  } while (0)
+
+/// Register a key in the membership filter.
+///
+/// @param[in] bloom membership filter
+/// @param[in] key   key hash
+#define LIST_BLOOM_ADD(bloom, key)                    \
+  do {                                                \
+    size_t _list_b;                                   \
+    uint64_t _list_m;                                 \
+    _LIST_BLOOM_BITS(&_list_b, &_list_m, bloom, key); \
+    (bloom)->_list_blk[_list_b] |= _list_m;           \
+  } while (0)
+
+/// Determine whether a key might be registered in the membership filter.
+///
+/// @param[out] out   false if definitely absent, true if possibly present
+/// @param[in]  bloom membership filter
+/// @param[in]  key   key hash
+#define LIST_BLOOM_TEST(out, bloom, key)                           \
+  do {                                                             \
+    size_t _list_b;                                                \
+    uint64_t _list_m;                                              \
+    _LIST_BLOOM_BITS(&_list_b, &_list_m, bloom, key);              \
+    *(out) = (((bloom)->_list_blk[_list_b] & _list_m) == _list_m); \
+  } while (0)
+
+/// Unregister all keys from the membership filter.
+///
+/// @param[in] bloom membership filter
+#define LIST_BLOOM_CLEAR(bloom)                                             \
+  do {                                                                      \
+    memset((bloom)->_list_blk, 0, (bloom)->_list_nbk * sizeof(uint64_t));   \
+  } while (0)
+
+/// Register the keys of all elements of the list in an emptied membership
+/// filter.
+///
+/// @param[in] bloom membership filter
+/// @param[in] list  list
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+/// @param[in] hfunc hash function
+#define LIST_BLOOM_REBUILD(bloom, list, type, link, hfunc) \
+  do {                                                     \
+    LIST_BLOOM_CLEAR(bloom);                               \
+    for (type* _list_e = _LIST_FST(list);                  \
+         _list_e != NULL;                                  \
+         _list_e = _LIST_NXT(_list_e, link))               \
+      LIST_BLOOM_ADD(bloom, hfunc(_list_e));               \
+  } while (0)
+
+/// Determine whether an element is present in the list. The elements must be
+/// registered in the filter by their address, using LIST_BLOOM_ADDR.
+///
+/// @param[out] out   true if present, false otherwise
+/// @param[in]  bloom membership filter
+/// @param[in]  list  list
+/// @param[in]  type  element C type name
+/// @param[in]  link  element link name
+/// @param[in]  elem  element
+#define LIST_BLOOM_MEMBER(out, bloom, list, type, link, elem) \
+  do {                                                        \
+    LIST_BLOOM_TEST(out, bloom, LIST_BLOOM_ADDR(elem));       \
+    if (*(out))                                               \
+      LIST_MEMBER(out, list, type, link, elem);               \
+  } while (0)
+
+/// Find the first element that satisfies the predicate, provided that the key
+/// it is searched by is possibly registered in the filter.
+///
+/// @param[out] out   first element that satisfies the predicate
+/// @param[in]  bloom membership filter
+/// @param[in]  list  list
+/// @param[in]  type  element C type name
+/// @param[in]  link  element link name
+/// @param[in]  key   key hash
+/// @param[in]  func  predicate function
+/// @param[in]  ...   variable-length arguments for the predicate function
+#define LIST_BLOOM_FIND(out, bloom, list, type, link, key, func, ...) \
+  do {                                                                \
+    bool _list_p;                                                     \
+    LIST_BLOOM_TEST(&_list_p, bloom, key);                            \
+    *(out) = NULL;                                                    \
+    if (_list_p)                                                      \
+      LIST_FIND(out, list, type, link, func, __VA_ARGS__);            \
+  } while (0)
+
+/// Release the membership filter.
+///
+/// @param[in] bloom membership filter
+#define LIST_BLOOM_FREE(bloom)      \
+  do {                              \
+    free((bloom)->_list_blk);       \
+    (bloom)->_list_blk = NULL;      \
+    (bloom)->_list_nbk = 0;         \
+  } while (0)
+#endif
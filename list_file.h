@@ -0,0 +1,226 @@
+// Copyright (c) 2017-2019 Daniel Lovasko
+// All Rights Reserved
+//
+// Distributed under the terms of the 2-clause BSD License. The full
+// license is in the file LICENSE, distributed as part of this software.
+
+#ifndef LIST_FILE_H
+#define LIST_FILE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "list.h"
+
+
+//////////////////////////////////////
+// Function    // Time complexity  //
+//////////////////////////////////////
+// LIST_DUMP   // O(n)             //
+// LIST_LOAD   // O(1) or O(n)     //
+// LIST_UNLOAD // O(1)             //
+//////////////////////////////////////
+
+// The file consists of a fixed-size header followed by the elements stored
+// back-to-back in the list order. Links between the elements are stored as
+// pointers valid for the file mapped at the base address recorded in the
+// header, with zero denoting the end of the list. Elements are copied
+// verbatim, and therefore must not contain any pointers other than the list
+// link.
+//
+// The loader maps the file privately at the recorded base address, so that
+// the stored links can be used as they are and the pages of the file are only
+// read on demand, shared with the page cache. Only if that address range is
+// already taken (e.g. by another loaded file dumped with the same base), the
+// file is mapped elsewhere and every link is rewritten, which copies all
+// pages of the file into private memory. Unless LIST_FILE_VERIFY is set to
+// zero, the loader additionally reads every link to verify that it refers to
+// the following element, which takes O(n) time but does not copy any pages.
+//
+// The loader depends on mmap(2) and pread(2), and thus requires a POSIX
+// feature test macro (e.g. _POSIX_C_SOURCE) to be defined when compiling with
+// a strict standard. Mapping at the base address without replacing existing
+// mappings relies on MAP_FIXED_NOREPLACE (exposed by glibc with
+// _DEFAULT_SOURCE), and the file is always relocated where it is unavailable.
+
+/// File format identifier ("LISTFILE").
+#define LIST_FILE_MAGIC UINT64_C(0x454c49465453494c)
+
+/// Size of the file header, chosen to keep the elements cache-line-aligned.
+#define LIST_FILE_HEADER 64
+
+/// Base address at which the dumped files are to be mapped.
+#ifndef LIST_FILE_BASE
+  #if UINTPTR_MAX > UINT32_MAX
+    #define LIST_FILE_BASE UINT64_C(0x200000000000)
+  #else
+    #define LIST_FILE_BASE UINT64_C(0x40000000)
+  #endif
+#endif
+
+/// Verify all links when loading a file that does not need to be relocated.
+#ifndef LIST_FILE_VERIFY
+  #define LIST_FILE_VERIFY 1
+#endif
+
+/// File header.
+struct list_file {
+  uint64_t lf_mag; ///< file format identifier
+  uint64_t lf_siz; ///< size of one element
+  uint64_t lf_cnt; ///< number of elements
+  uint64_t lf_bas; ///< base address the links are stored against
+};
+
+/// Memory mapping backing a loaded list.
+struct list_map {
+  void*  lm_base; ///< start of the mapping
+  size_t lm_size; ///< length of the mapping
+};
+
+/// Write all elements of the list to a file.
+///
+/// @param[out] out  success/failure
+/// @param[in]  list list
+/// @param[in]  type element C type name
+/// @param[in]  link element link name
+/// @param[in]  file stdio file stream
+#define LIST_DUMP(out, list, type, link, file)                              \
+  do {                                                                      \
+    unsigned char _list_h[LIST_FILE_HEADER] = {0};                          \
+    struct list_file _list_f;                                               \
+    type _list_t;                                                           \
+    intmax_t _list_c;                                                       \
+    intmax_t _list_i;                                                       \
+    LIST_LENGTH(&_list_c, list, type, link);                                \
+    _list_f.lf_mag = LIST_FILE_MAGIC;                                       \
+    _list_f.lf_siz = sizeof(type);                                          \
+    _list_f.lf_cnt = (uint64_t)_list_c;                                     \
+    _list_f.lf_bas = LIST_FILE_BASE;                                        \
+    memcpy(_list_h, &_list_f, sizeof(_list_f));                             \
+    *(out) = fwrite(_list_h, sizeof(_list_h), 1, file) == 1;                \
+    _list_i = 1;                                                            \
+    for (type* _list_e = _LIST_FST(list);                                   \
+         _list_e != NULL && *(out);                                         \
+         _list_e = _LIST_NXT(_list_e, link), _list_i++) {                   \
+      _list_t = *_list_e;                                                   \
+      _LIST_NXT(&_list_t, link) = (type*)(uintptr_t)(_list_i < _list_c      \
+        ? LIST_FILE_BASE + LIST_FILE_HEADER                                 \
+          + (uint64_t)_list_i * sizeof(type) : 0);                          \
+      *(out) = fwrite(&_list_t, sizeof(type), 1, file) == 1;                \
+    }                                                                       \
+  } while (0)
+
+/// Internal function to map a file at the given base address, without
+/// replacing any existing mapping. Please note that this function is for
+/// internal use only and should not be used in your code.
+///
+/// @param[out] out  start of the mapping or MAP_FAILED
+/// @param[in]  base base address
+/// @param[in]  size length of the mapping
+/// @param[in]  fd   file descriptor
+#ifdef MAP_FIXED_NOREPLACE
+  #define _LIST_FILE_MAP(out, base, size, fd)                                  \
+    do {                                                                       \
+      (out) = mmap((void*)(uintptr_t)(base), size, PROT_READ | PROT_WRITE,     \
+                   MAP_PRIVATE | MAP_FIXED_NOREPLACE, fd, 0);                  \
+      if ((out) != MAP_FAILED && (out) != (void*)(uintptr_t)(base)) {          \
+        munmap(out, size);                                                     \
+        (out) = MAP_FAILED;                                                    \
+      }                                                                        \
+    } while (0)
+#else
+  #define _LIST_FILE_MAP(out, base, size, fd) \
+    do {                                      \
+      (out) = MAP_FAILED;                     \
+    } while (0)
+#endif
+
+/// Map a file written by LIST_DUMP and attach its elements to the list.
+///
+/// The file is mapped privately with copy-on-write semantics, so that the
+/// elements can be modified without affecting the file. No memory is
+/// allocated for the elements. The loading fails if the header does not match
+/// the element type, if the file is truncated, or if any link does not refer
+/// to the element that follows it in the file. The elements must not be
+/// released individually: remove them with a no-op deallocation function and
+/// release the mapping by LIST_UNLOAD.
+///
+/// @param[out] out  success/failure
+/// @param[in]  list list
+/// @param[in]  type element C type name
+/// @param[in]  link element link name
+/// @param[out] map  memory mapping
+/// @param[in]  fd   file descriptor
+#define LIST_LOAD(out, list, type, link, map, fd)                             \
+  do {                                                                        \
+    struct stat _list_s;                                                      \
+    struct list_file _list_f;                                                 \
+    unsigned char* _list_b = MAP_FAILED;                                      \
+    uint64_t _list_o;                                                         \
+    uint64_t _list_i;                                                         \
+    size_t _list_z;                                                           \
+    type* _list_e;                                                            \
+    bool _list_r;                                                             \
+    *(out) = false;                                                           \
+    (map)->lm_base = NULL;                                                    \
+    (map)->lm_size = 0;                                                       \
+    if (fstat(fd, &_list_s) == -1 || _list_s.st_size < LIST_FILE_HEADER       \
+        || pread(fd, &_list_f, sizeof(_list_f), 0) != sizeof(_list_f))        \
+      break;                                                                  \
+    _list_z = (size_t)_list_s.st_size;                                        \
+    if (_list_f.lf_mag != LIST_FILE_MAGIC                                     \
+        || _list_f.lf_siz != sizeof(type)                                     \
+        || _list_f.lf_cnt != (_list_z - LIST_FILE_HEADER) / sizeof(type)      \
+        || (_list_z - LIST_FILE_HEADER) % sizeof(type) != 0)                  \
+      break;                                                                  \
+    _LIST_FILE_MAP(_list_b, _list_f.lf_bas, _list_z, fd);                     \
+    _list_r = (_list_b != (unsigned char*)(uintptr_t)_list_f.lf_bas);         \
+    if (_list_b == MAP_FAILED)                                                \
+      _list_b = mmap(NULL, _list_z, PROT_READ | PROT_WRITE, MAP_PRIVATE,      \
+                     fd, 0);                                                  \
+    if (_list_b == MAP_FAILED)                                                \
+      break;                                                                  \
+    *(out) = true;                                                            \
+    for (_list_i = 0;                                                         \
+         _list_i < _list_f.lf_cnt && (_list_r || LIST_FILE_VERIFY);           \
+         _list_i++) {                                                         \
+      _list_e = (type*)(_list_b + LIST_FILE_HEADER + _list_i * sizeof(type)); \
+      _list_o = (uint64_t)(uintptr_t)_LIST_NXT(_list_e, link);                \
+      if (_list_o != (_list_i + 1 < _list_f.lf_cnt                            \
+                      ? _list_f.lf_bas + LIST_FILE_HEADER                     \
+                        + (_list_i + 1) * sizeof(type)                        \
+                      : 0)) {                                                 \
+        *(out) = false;                                                       \
+        break;                                                                \
+      }                                                                       \
+      if (_list_r && _list_o != 0)                                            \
+        _LIST_NXT(_list_e, link) = (type*)(_list_b + (_list_o                 \
+                                                      - _list_f.lf_bas));     \
+    }                                                                         \
+    if (!*(out)) {                                                            \
+      munmap(_list_b, _list_z);                                               \
+      break;                                                                  \
+    }                                                                         \
+    _list_e = (type*)(_list_b + LIST_FILE_HEADER);                            \
+    _LIST_FST(list) = _list_f.lf_cnt == 0 ? NULL : _list_e;                   \
+    (map)->lm_base = _list_b;                                                 \
+    (map)->lm_size = _list_z;                                                 \
+  } while (0)
+
+/// Detach all elements from the list and release the backing mapping.
+///
+/// @param[in] list list
+/// @param[in] map  memory mapping
+#define LIST_UNLOAD(list, map)                       \
+  do {                                               \
+    if ((map)->lm_base != NULL)                      \
+      munmap((map)->lm_base, (map)->lm_size);        \
+    (map)->lm_base = NULL;                           \
+    (map)->lm_size = 0;                              \
+    _LIST_FST(list) = NULL;                          \
+  } while (0)
+#endif
@@ -0,0 +1,310 @@
+// Copyright (c) 2017-2019 Daniel Lovasko
+// All Rights Reserved
+//
+// Distributed under the terms of the 2-clause BSD License. The full
+// license is in the file LICENSE, distributed as part of this software.
+
+#ifndef LIST_RCU_H
+#define LIST_RCU_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "list.h"
+
+
+//////////////////////////////////////////
+// Function           // Time complexity //
+//////////////////////////////////////////
+// LIST_RCU_LINK      // compile time     //
+// LIST_EPOCH_TYPE    // compile time     //
+// LIST_RCU_FIRST     // O(1)             //
+// LIST_RCU_NEXT      // O(1)             //
+// LIST_RCU_MAP       // O(n)             //
+// LIST_RCU_FIND      // O(n)             //
+// LIST_RCU_PUSH      // O(1)             //
+// LIST_RCU_INSERT    // O(1)             //
+// LIST_RCU_POP       // O(1)             //
+// LIST_RCU_REMOVE    // O(1)             //
+// LIST_EPOCH_NEW     // O(r)             //
+// LIST_EPOCH_ENTER   // O(1)             //
+// LIST_EPOCH_EXIT    // O(1)             //
+// LIST_EPOCH_RETIRE  // O(1)             //
+// LIST_EPOCH_RECLAIM // O(r + m)         //
+// LIST_EPOCH_FREE    // O(m)             //
+//////////////////////////////////////////
+
+// The list can be traversed by any number of readers concurrently with a
+// single writer. The writer publishes new elements with release stores to
+// the links, and the readers follow the links with acquire loads, so that a
+// reader always observes a fully initialised element. Removed elements keep
+// their links intact, as readers might still be traversing them, and are
+// handed over to an epoch-based reclamation domain instead of being released
+// right away.
+//
+// Each reader owns a slot in the domain, identified by an index in the range
+// [0, r). A reader announces the global epoch it observed in its slot before
+// traversing the list, and clears the slot afterwards. Removed elements are
+// stamped with the global epoch at the time of their removal, and are only
+// released once no reader has announced an epoch lower or equal to the stamp.
+//
+// The writer is free to use all non-modifying LIST_* macros on the list, as
+// the element link starts with the same field as LIST_LINK. The atomic
+// operations rely on the __atomic built-in functions of GCC and Clang.
+
+/// Definition of a new element link for concurrently traversed lists.
+///
+/// @param[in] tag struct tag name
+#define LIST_RCU_LINK(tag) \
+  struct {                 \
+    struct tag* _list_nxt; \
+    struct tag* _list_ret; \
+    uint64_t    _list_epo; \
+  }
+
+/// Definition of a new reclamation domain type.
+///
+/// @param[in] tag  struct tag name
+/// @param[in] type list element type
+#define LIST_EPOCH_TYPE(tag, type)                                 \
+  struct tag {                                                     \
+    type*    _list_ret;                                            \
+    uint64_t _list_glb;                                            \
+    struct {                                                       \
+      uint64_t      _list_epo;                                     \
+      unsigned char _list_pad[LIST_CACHE_LINE - sizeof(uint64_t)]; \
+    }*       _list_rdr;                                            \
+    void*    _list_mem;                                            \
+    size_t   _list_nrd;                                            \
+  }
+
+/// Obtain the first element of a concurrently modified list.
+///
+/// @param[out] out  first element
+/// @param[in]  list list
+#define LIST_RCU_FIRST(out, list)                                  \
+  do {                                                             \
+    *(out) = __atomic_load_n(&_LIST_FST(list), __ATOMIC_ACQUIRE);  \
+  } while (0)
+
+/// Obtain the next linked element of a concurrently modified list.
+///
+/// @param[out] out  next element
+/// @param[in]  elem element
+/// @param[in]  link element link name
+#define LIST_RCU_NEXT(out, elem, link)                                  \
+  do {                                                                  \
+    *(out) = __atomic_load_n(&_LIST_NXT(elem, link), __ATOMIC_ACQUIRE); \
+  } while (0)
+
+/// Traverse a concurrently modified list and execute a function for each
+/// element. The caller must be inside a read-side critical section.
+///
+/// @param[in] list list
+/// @param[in] type element C type name
+/// @param[in] link element link name
+/// @param[in] func function
+/// @param[in] ...  variable-length arguments for the function
+#define LIST_RCU_MAP(list, type, link, func, ...) \
+  do {                                            \
+    type* _list_e;                                \
+    intmax_t _list_i = 0;                         \
+    LIST_RCU_FIRST(&_list_e, list);               \
+    while (_list_e != NULL) {                     \
+      func(_list_e, _list_i, __VA_ARGS__);        \
+      LIST_RCU_NEXT(&_list_e, _list_e, link);     \
+      _list_i++;                                  \
+    }                                             \
+  } while (0)
+
+/// Find the first matching element of a concurrently modified list.
+/// The caller must be inside a read-side critical section.
+///
+/// @param[out] out  matching element or NULL
+/// @param[in]  list list
+/// @param[in]  type element C type name
+/// @param[in]  link element link name
+/// @param[in]  func matching function
+/// @param[in]  ...  variable-length arguments for the matching function
+#define LIST_RCU_FIND(out, list, type, link, func, ...) \
+  do {                                                  \
+    type* _list_e;                                      \
+    *(out) = NULL;                                      \
+    LIST_RCU_FIRST(&_list_e, list);                     \
+    while (_list_e != NULL) {                           \
+      if (func(_list_e, __VA_ARGS__)) {                 \
+        *(out) = _list_e;                               \
+        break;                                          \
+      }                                                 \
+      LIST_RCU_NEXT(&_list_e, _list_e, link);           \
+    }                                                   \
+  } while (0)
+
+/// Publish an element at the head of a concurrently traversed list.
+///
+/// @param[in] list list
+/// @param[in] elem element
+/// @param[in] link element link name
+#define LIST_RCU_PUSH(list, elem, link)                               \
+  do {                                                                \
+    __atomic_store_n(&_LIST_NXT(elem, link), _LIST_FST(list),         \
+                     __ATOMIC_RELAXED);                               \
+    __atomic_store_n(&_LIST_FST(list), (elem), __ATOMIC_RELEASE);     \
+  } while (0)
+
+/// Publish an element after the specified element of a concurrently
+/// traversed list.
+///
+/// @param[in] elem  element
+/// @param[in] toadd element to be added
+/// @param[in] link  element link name
+#define LIST_RCU_INSERT(elem, toadd, link)                            \
+  do {                                                                \
+    __atomic_store_n(&_LIST_NXT(toadd, link), _LIST_NXT(elem, link),  \
+                     __ATOMIC_RELAXED);                               \
+    __atomic_store_n(&_LIST_NXT(elem, link), (toadd),                 \
+                     __ATOMIC_RELEASE);                               \
+  } while (0)
+
+/// Unlink an element from the head of a concurrently traversed list and
+/// retire it to the reclamation domain.
+///
+/// @param[in] list list
+/// @param[in] type element C type name
+/// @param[in] link element link name
+/// @param[in] dom  reclamation domain
+#define LIST_RCU_POP(list, type, link, dom)                           \
+  do {                                                                \
+    type* _list_e = _LIST_FST(list);                                  \
+    if (_list_e == NULL)                                              \
+      break;                                                          \
+    __atomic_store_n(&_LIST_FST(list), _LIST_NXT(_list_e, link),      \
+                     __ATOMIC_RELEASE);                               \
+    LIST_EPOCH_RETIRE(dom, _list_e, link);                            \
+  } while (0)
+
+/// Unlink an element that is linked to the specified element of a
+/// concurrently traversed list and retire it to the reclamation domain.
+///
+/// @param[in] elem element
+/// @param[in] type element C type name
+/// @param[in] link element link name
+/// @param[in] dom  reclamation domain
+#define LIST_RCU_REMOVE(elem, type, link, dom)                        \
+  do {                                                                \
+    type* _list_e = _LIST_NXT(elem, link);                            \
+    if (_list_e == NULL)                                              \
+      break;                                                          \
+    __atomic_store_n(&_LIST_NXT(elem, link),                          \
+                     _LIST_NXT(_list_e, link), __ATOMIC_RELEASE);     \
+    LIST_EPOCH_RETIRE(dom, _list_e, link);                            \
+  } while (0)
+
+/// Initialise the reclamation domain.
+///
+/// @param[out] out success/failure
+/// @param[in]  dom reclamation domain
+/// @param[in]  n   number of reader slots
+#define LIST_EPOCH_NEW(out, dom, n)                                          \
+  do {                                                                       \
+    (dom)->_list_ret = NULL;                                                 \
+    (dom)->_list_glb = 1;                                                    \
+    (dom)->_list_nrd = (size_t)(n);                                          \
+    (dom)->_list_mem = calloc(1, (dom)->_list_nrd                            \
+                                 * sizeof(*(dom)->_list_rdr)                 \
+                                 + LIST_CACHE_LINE - 1);                     \
+    *(out) = ((dom)->_list_mem != NULL);                                     \
+    (dom)->_list_rdr = (void*)(((uintptr_t)(dom)->_list_mem                  \
+                                + LIST_CACHE_LINE - 1)                       \
+                               & ~(uintptr_t)(LIST_CACHE_LINE - 1));         \
+  } while (0)
+
+/// Enter a read-side critical section.
+///
+/// @param[in] dom  reclamation domain
+/// @param[in] slot reader slot index
+#define LIST_EPOCH_ENTER(dom, slot)                                          \
+  do {                                                                       \
+    __atomic_store_n(&(dom)->_list_rdr[slot]._list_epo,                      \
+                     __atomic_load_n(&(dom)->_list_glb, __ATOMIC_ACQUIRE),   \
+                     __ATOMIC_RELAXED);                                      \
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);                                 \
+  } while (0)
+
+/// Leave a read-side critical section.
+///
+/// @param[in] dom  reclamation domain
+/// @param[in] slot reader slot index
+#define LIST_EPOCH_EXIT(dom, slot)                                           \
+  do {                                                                       \
+    __atomic_store_n(&(dom)->_list_rdr[slot]._list_epo, 0,                   \
+                     __ATOMIC_RELEASE);                                      \
+  } while (0)
+
+/// Defer the deallocation of an unlinked element until no reader can
+/// reference it.
+///
+/// @param[in] dom  reclamation domain
+/// @param[in] elem element
+/// @param[in] link element link name
+#define LIST_EPOCH_RETIRE(dom, elem, link)                                   \
+  do {                                                                       \
+    (elem)->link._list_epo = (dom)->_list_glb;                               \
+    (elem)->link._list_ret = (dom)->_list_ret;                               \
+    (dom)->_list_ret = (elem);                                               \
+  } while (0)
+
+/// Advance the global epoch and release all retired elements that are no
+/// longer reachable by any reader.
+///
+/// @param[in] dom   reclamation domain
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+/// @param[in] clean deallocation function
+#define LIST_EPOCH_RECLAIM(dom, type, link, clean)                           \
+  do {                                                                       \
+    type** _list_c = &(dom)->_list_ret;                                      \
+    type* _list_e;                                                           \
+    uint64_t _list_m;                                                        \
+    uint64_t _list_r;                                                        \
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);                                 \
+    _list_m = __atomic_add_fetch(&(dom)->_list_glb, 1, __ATOMIC_SEQ_CST);    \
+    for (size_t _list_i = 0; _list_i < (dom)->_list_nrd; _list_i++) {        \
+      _list_r = __atomic_load_n(&(dom)->_list_rdr[_list_i]._list_epo,        \
+                                __ATOMIC_SEQ_CST);                           \
+      if (_list_r != 0 && _list_r < _list_m)                                 \
+        _list_m = _list_r;                                                   \
+    }                                                                        \
+    while (*_list_c != NULL) {                                               \
+      _list_e = *_list_c;                                                    \
+      if (_list_e->link._list_epo < _list_m) {                               \
+        *_list_c = _list_e->link._list_ret;                                  \
+        if (clean != NULL)                                                   \
+          clean(_list_e);                                                    \
+      } else {                                                               \
+        _list_c = &_list_e->link._list_ret;                                  \
+      }                                                                      \
+    }                                                                        \
+  } while (0)
+
+/// Release all retired elements and the reader slots of the domain. No
+/// reader may be inside a read-side critical section.
+///
+/// @param[in] dom   reclamation domain
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+/// @param[in] clean deallocation function
+#define LIST_EPOCH_FREE(dom, type, link, clean)                              \
+  do {                                                                       \
+    type* _list_e;                                                           \
+    while ((dom)->_list_ret != NULL) {                                       \
+      _list_e = (dom)->_list_ret;                                            \
+      (dom)->_list_ret = _list_e->link._list_ret;                            \
+      if (clean != NULL)                                                     \
+        clean(_list_e);                                                      \
+    }                                                                        \
+    free((dom)->_list_mem);                                                  \
+    (dom)->_list_mem = NULL;                                                 \
+    (dom)->_list_rdr = NULL;                                                 \
+  } while (0)
+#endif
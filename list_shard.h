@@ -0,0 +1,164 @@
+// Copyright (c) 2017-2019 Daniel Lovasko
+// All Rights Reserved
+//
+// Distributed under the terms of the 2-clause BSD License. The full
+// license is in the file LICENSE, distributed as part of this software.
+
+#ifndef LIST_SHARD_H
+#define LIST_SHARD_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "list.h"
+
+
+//////////////////////////////////////////
+// Function          // Time complexity //
+//////////////////////////////////////////
+// LIST_SHARD_TYPE   // compile time    //
+// LIST_SHARD_NEW    // O(s)            //
+// LIST_SHARD_PUSH   // O(1)            //
+// LIST_SHARD_DRAIN  // O(s + n)        //
+// LIST_SHARD_LENGTH // O(s)            //
+// LIST_SHARD_FREE   // O(s + n)        //
+//////////////////////////////////////////
+
+// The sharded list consists of s independent list heads, each padded to
+// occupy its own cache line. Producers push elements only to their own shard,
+// identified by an index in the range [0, s) (e.g. a thread or CPU number),
+// so that concurrent producers never contend on the same cache line. The push
+// is lock-free and only competes with a concurrent drain of the same shard.
+//
+// The drain detaches each shard with a single atomic exchange and splices its
+// elements to the head of an ordinary list. Elements from one shard retain
+// their relative order (newest first, as with LIST_PUSH), while the order of
+// the shards is unspecified. The per-shard element counters are maintained
+// with relaxed atomic operations and are only summed up on demand, and the
+// resulting length is therefore approximate while producers are active.
+//
+// The atomic operations rely on the __atomic built-in functions of GCC and
+// Clang.
+
+/// Definition of a new sharded list type.
+///
+/// @param[in] tag  struct tag name
+/// @param[in] type list element type
+#define LIST_SHARD_TYPE(tag, type)                                  \
+  struct tag {                                                      \
+    struct {                                                        \
+      type*         _list_fst;                                      \
+      intmax_t      _list_cnt;                                      \
+      unsigned char _list_pad[LIST_CACHE_LINE - sizeof(type*)       \
+                                              - sizeof(intmax_t)];  \
+    }*     _list_shd;                                               \
+    void*  _list_mem;                                               \
+    size_t _list_nsh;                                               \
+  }
+
+/// Initialise the sharded list. At least one shard is required.
+///
+/// @param[out] out   success/failure
+/// @param[in]  shard sharded list
+/// @param[in]  n     number of shards
+#define LIST_SHARD_NEW(out, shard, n)                                       \
+  do {                                                                      \
+    (shard)->_list_nsh = (size_t)(n);                                       \
+    (shard)->_list_mem = NULL;                                              \
+    if ((shard)->_list_nsh > 0)                                             \
+      (shard)->_list_mem = calloc(1, (shard)->_list_nsh                     \
+                                     * sizeof(*(shard)->_list_shd)          \
+                                     + LIST_CACHE_LINE - 1);                \
+    if ((shard)->_list_mem == NULL)                                         \
+      (shard)->_list_nsh = 0;                                               \
+    *(out) = ((shard)->_list_mem != NULL);                                  \
+    (shard)->_list_shd = (void*)(((uintptr_t)(shard)->_list_mem             \
+                                  + LIST_CACHE_LINE - 1)                    \
+                                 & ~(uintptr_t)(LIST_CACHE_LINE - 1));      \
+  } while (0)
+
+/// Insert an element to the head of a shard.
+///
+/// @param[in] shard sharded list
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+/// @param[in] i     shard index
+/// @param[in] elem  element
+#define LIST_SHARD_PUSH(shard, type, link, i, elem)                      \
+  do {                                                                   \
+    size_t _list_s = (size_t)(i) % (shard)->_list_nsh;                   \
+    type* _list_h;                                                       \
+    _list_h = __atomic_load_n(&(shard)->_list_shd[_list_s]._list_fst,    \
+                              __ATOMIC_RELAXED);                         \
+    do {                                                                 \
+      _LIST_NXT(elem, link) = _list_h;                                   \
+    } while (!__atomic_compare_exchange_n(                               \
+               &(shard)->_list_shd[_list_s]._list_fst, &_list_h, (elem), \
+               true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));               \
+    __atomic_fetch_add(&(shard)->_list_shd[_list_s]._list_cnt, 1,        \
+                       __ATOMIC_RELAXED);                                \
+  } while (0)
+
+/// Move all elements from all shards to the head of an ordinary list.
+///
+/// @param[in] shard sharded list
+/// @param[in] list  list
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+#define LIST_SHARD_DRAIN(shard, list, type, link)                           \
+  do {                                                                      \
+    type* _list_f;                                                          \
+    type* _list_l;                                                          \
+    intmax_t _list_c;                                                       \
+    for (size_t _list_s = 0; _list_s < (shard)->_list_nsh; _list_s++) {     \
+      _list_f = __atomic_exchange_n(&(shard)->_list_shd[_list_s]._list_fst, \
+                                    NULL, __ATOMIC_ACQUIRE);                \
+      if (_list_f == NULL)                                                  \
+        continue;                                                           \
+      _list_l = _list_f;                                                    \
+      _list_c = 1;                                                          \
+      while (_LIST_NXT(_list_l, link) != NULL) {                            \
+        _list_l = _LIST_NXT(_list_l, link);                                 \
+        _list_c++;                                                          \
+      }                                                                     \
+      _LIST_NXT(_list_l, link) = _LIST_FST(list);                           \
+      _LIST_FST(list) = _list_f;                                            \
+      __atomic_fetch_sub(&(shard)->_list_shd[_list_s]._list_cnt, _list_c,   \
+                         __ATOMIC_RELAXED);                                 \
+    }                                                                       \
+  } while (0)
+
+/// Compute the total number of elements in all shards.
+///
+/// A counter of a shard can be temporarily negative, as a drain might
+/// subtract an element that a concurrent push has linked but not counted yet.
+/// The total is therefore clamped at zero.
+///
+/// @param[out] out   number of elements
+/// @param[in]  shard sharded list
+#define LIST_SHARD_LENGTH(out, shard)                                       \
+  do {                                                                      \
+    intmax_t _list_t = 0;                                                   \
+    for (size_t _list_s = 0; _list_s < (shard)->_list_nsh; _list_s++)       \
+      _list_t += __atomic_load_n(&(shard)->_list_shd[_list_s]._list_cnt,    \
+                                 __ATOMIC_RELAXED);                         \
+    *(out) = _list_t > 0 ? _list_t : 0;                                     \
+  } while (0)
+
+/// Remove all elements from all shards and release the shards. No producer
+/// may be pushing elements concurrently.
+///
+/// @param[in] shard sharded list
+/// @param[in] type  element C type name
+/// @param[in] link  element link name
+/// @param[in] clean deallocation function
+#define LIST_SHARD_FREE(shard, type, link, clean)                           \
+  do {                                                                      \
+    for (size_t _list_s = 0; _list_s < (shard)->_list_nsh; _list_s++)       \
+      LIST_FREE(&(shard)->_list_shd[_list_s], type, link, clean);           \
+    free((shard)->_list_mem);                                               \
+    (shard)->_list_mem = NULL;                                              \
+    (shard)->_list_shd = NULL;                                              \
+    (shard)->_list_nsh = 0;                                                 \
+  } while (0)
+#endif
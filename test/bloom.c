@@ -0,0 +1,119 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "../list_bloom.h"
+
+
+/// Element.
+typedef struct _elem {
+  LIST_LINK(_elem) el_link;
+  int              el_num;
+} elem;
+
+/// List.
+typedef LIST_TYPE(_list, elem) list;
+
+/// Membership filter.
+typedef LIST_BLOOM_TYPE(_bloom) bloom;
+
+/// Compute the key of the element from the number it stores.
+/// @return key hash
+///
+/// @param[in] a element
+static uint64_t
+elem_key(const elem* a)
+{
+  return (uint64_t)a->el_num;
+}
+
+/// Determine whether the element stores the given number.
+/// @return decision
+///
+/// @param[in] a element
+/// @param[in] n number
+static bool
+has_num(const elem* a, int n)
+{
+  return a->el_num == n;
+}
+
+int
+main(void)
+{
+  static elem a[1000];
+  static bool present[100000];
+  list l;
+  bloom b;
+  bloom p;
+  elem* e;
+  bool res;
+  bool ok;
+  int i;
+  int k;
+  int m;
+  int n;
+  int fp;
+
+  srand(time(NULL));
+
+  for (i = 0; i < 100; i++) {
+    m = (rand() % 1000) + 1;
+    LIST_NEW(&l);
+    LIST_BLOOM_NEW(&ok, &b, m);
+    LIST_BLOOM_NEW(&ok, &p, m);
+    if (!ok) {
+      printf("Unable to allocate the membership filter.\n");
+      return EXIT_FAILURE;
+    }
+
+    // Insert the elements and register them by their key and address.
+    for (k = 0; k < m; k++) {
+      a[k].el_num = rand() % 100000;
+      present[a[k].el_num] = true;
+      LIST_PUSH(&l, &a[k], el_link);
+      LIST_BLOOM_ADD(&b, elem_key(&a[k]));
+      if (k % 2 == 0)
+        LIST_BLOOM_ADD(&p, LIST_BLOOM_ADDR(&a[k]));
+    }
+    LIST_BLOOM_REBUILD(&p, &l, elem, el_link, LIST_BLOOM_ADDR);
+
+    // Verify that the filters never reject an element of the list.
+    for (k = 0; k < m; k++) {
+      LIST_BLOOM_MEMBER(&res, &p, &l, elem, el_link, &a[k]);
+      LIST_BLOOM_FIND(&e, &b, &l, elem, el_link, elem_key(&a[k]),
+                      has_num, a[k].el_num);
+      if (!res || e == NULL || e->el_num != a[k].el_num) {
+        printf("Element %d was not found.\n", a[k].el_num);
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Verify that the filter rejects most of the absent keys.
+    fp = 0;
+    for (n = 0; n < 100000; n++) {
+      if (present[n])
+        continue;
+
+      LIST_BLOOM_TEST(&res, &b, (uint64_t)n);
+      LIST_BLOOM_FIND(&e, &b, &l, elem, el_link, (uint64_t)n, has_num, n);
+      if (e != NULL) {
+        printf("Absent element %d was found.\n", n);
+        return EXIT_FAILURE;
+      }
+      fp += res;
+    }
+    if (fp > 100000 / 20) {
+      printf("Too many false positives: %d.\n", fp);
+      return EXIT_FAILURE;
+    }
+
+    for (k = 0; k < m; k++)
+      present[a[k].el_num] = false;
+    LIST_BLOOM_FREE(&b);
+    LIST_BLOOM_FREE(&p);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "../list.h"
+
+
+/// Element.
+typedef struct _elem {
+  LIST_LINK(_elem) el_link;
+  int              el_num;
+  int              el_idx;
+} elem;
+
+/// List.
+typedef LIST_TYPE(_list, elem) list;
+
+/// Update the external pointer to a relocated element.
+///
+/// @param[in] n new location of the element
+/// @param[in] o old location of the element
+/// @param[in] p external pointers to the elements
+static void
+fixup(elem* n, elem* o, elem** p)
+{
+  if (p[n->el_idx] != o) {
+    printf("Fixup called with unexpected element %d.\n", n->el_idx);
+    exit(EXIT_FAILURE);
+  }
+
+  p[n->el_idx] = n;
+}
+
+/// Keep an element that resides in the block of compacted elements.
+///
+/// @param[in] a unused element
+static void
+ignore(elem* a)
+{
+  (void)a;
+}
+
+/// Determine whether the element is marked for removal.
+/// @return decision
+///
+/// @param[in] a element
+/// @param[in] i unused index of the element
+/// @param[in] p unused payload pointer
+static bool
+is_removed(const elem* a, intmax_t i, void* p)
+{
+  (void)i;
+  (void)p;
+
+  return a->el_num < 0;
+}
+
+/// Verify that the list contains the expected elements in the expected order,
+/// stored contiguously, and that the external pointers refer to them.
+/// @return decision
+///
+/// @param[in] l list
+/// @param[in] b block of compacted elements
+/// @param[in] p external pointers to the elements
+/// @param[in] v expected numbers
+/// @param[in] n number of expected numbers
+static bool
+verify(list* l, struct list_block* b, elem** p, const int* v, int n)
+{
+  elem* f;
+  elem* e;
+  int k;
+
+  if (b->lb_cnt != n)
+    return false;
+
+  LIST_FIRST(&f, l);
+  if (n > 0 && (uintptr_t)f % LIST_CACHE_LINE != 0)
+    return false;
+
+  e = f;
+  for (k = 0; k < n; k++) {
+    if (e != f + k || e->el_num != v[k] || p[e->el_idx] != e)
+      return false;
+
+    LIST_NEXT(&e, e, el_link);
+  }
+
+  return e == NULL;
+}
+
+int
+main(void)
+{
+  static elem* p[2000];
+  static int v[2000];
+  struct list_block b;
+  list l;
+  elem* e;
+  bool ok;
+  int i;
+  int k;
+  int m;
+  int n;
+  int c;
+
+  srand(time(NULL));
+
+  for (i = 0; i < 1000; i++) {
+    LIST_NEW(&l);
+    b.lb_mem = NULL;
+    b.lb_cnt = 0;
+
+    // Create the elements, with the number encoding their index.
+    m = rand() % 1000;
+    for (k = 0; k < m; k++) {
+      e = malloc(sizeof(elem));
+      e->el_idx = k;
+      e->el_num = k * 1000 + rand() % 1000;
+      p[k] = e;
+      LIST_PUSH(&l, e, el_link);
+    }
+    for (k = 0; k < m; k++)
+      v[k] = p[m - k - 1]->el_num;
+
+    // Compact the list and verify the order and the external pointers.
+    LIST_COMPACT(&ok, &b, &l, elem, el_link, free, fixup, p);
+    if (!ok || !verify(&l, &b, p, v, m)) {
+      printf("First compaction failed.\n");
+      return EXIT_FAILURE;
+    }
+
+    // Remove some of the compacted elements and add new elements.
+    n = 0;
+    for (k = 0; k < m; k++)
+      if (rand() % 4 == 0)
+        p[m - k - 1]->el_num = -1;
+    LIST_FILTER(&l, elem, el_link, ignore, is_removed, NULL);
+    for (k = 0; k < m; k++)
+      if (p[m - k - 1]->el_num >= 0)
+        v[n++] = p[m - k - 1]->el_num;
+
+    c = rand() % 1000;
+    for (k = m; k < m + c; k++) {
+      e = malloc(sizeof(elem));
+      e->el_idx = k;
+      e->el_num = k * 1000 + rand() % 1000;
+      p[k] = e;
+      LIST_PUSH(&l, e, el_link);
+    }
+    for (k = n - 1; k >= 0; k--)
+      v[k + c] = v[k];
+    for (k = 0; k < c; k++)
+      v[k] = p[m + c - k - 1]->el_num;
+
+    // Compact the list again, releasing only the newly added elements.
+    LIST_COMPACT(&ok, &b, &l, elem, el_link, free, fixup, p);
+    if (!ok || !verify(&l, &b, p, v, n + c)) {
+      printf("Second compaction failed.\n");
+      return EXIT_FAILURE;
+    }
+
+    // Add one more element and release everything.
+    e = malloc(sizeof(elem));
+    LIST_PUSH(&l, e, el_link);
+    LIST_COMPACT_FREE(&b, &l, elem, el_link, free);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,200 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "../dlist.h"
+
+
+/// Element.
+typedef struct _elem {
+  DLIST_LINK(_elem) el_link;
+  int               el_num;
+} elem;
+
+/// List.
+typedef DLIST_TYPE(_list, elem) list;
+
+/// Compare two elements by the numerical value they store.
+/// @return comparison result
+/// @retval  0 a and b equal
+/// @retval  1 a is greater
+/// @retval -1 b is greater
+///
+/// @param[in] a first element
+/// @param[in] b second element
+/// @param[in] p unused payload pointer
+static int
+compare(const elem* a, const elem* b, void* p)
+{
+  (void)p;
+
+  if (a->el_num == b->el_num)
+    return 0;
+
+  if (a->el_num > b->el_num)
+    return 1;
+  else
+    return -1;
+}
+
+/// Determine whether the number stored in the element is odd.
+/// @return decision
+///
+/// @param[in] a element
+/// @param[in] i unused index of the element
+/// @param[in] p unused payload pointer
+static bool
+is_odd(const elem* a, intmax_t i, void* p)
+{
+  (void)i;
+  (void)p;
+
+  return (a->el_num % 2) != 0;
+}
+
+/// Verify that the forward and backward links of the list agree and that the
+/// list contains the expected elements.
+/// @return decision
+///
+/// @param[in] l list
+/// @param[in] a expected elements
+/// @param[in] n number of expected elements
+static bool
+verify(const list* l, elem** a, int n)
+{
+  elem* e;
+  elem* p;
+  int i;
+
+  p = NULL;
+  i = 0;
+  DLIST_FIRST(&e, l);
+  while (e != NULL) {
+    if (i == n || e != a[i] || e->el_link._list_prv != p)
+      return false;
+
+    p = e;
+    i++;
+    DLIST_NEXT(&e, e, el_link);
+  }
+
+  DLIST_LAST(&e, l);
+  return i == n && e == p;
+}
+
+int
+main(void)
+{
+  list l;
+  elem* a[128];
+  elem* e;
+  int i;
+  int k;
+  int m;
+  int n;
+  int r;
+
+  srand(time(NULL));
+
+  for (i = 0; i < 100000; i++) {
+    m = (rand() % 100) + 1;
+
+    // Build the list from both ends.
+    DLIST_NEW(&l);
+    n = 0;
+    for (k = 0; k < m; k++) {
+      e = malloc(sizeof(elem));
+      e->el_num = rand() % 20;
+      if (rand() % 2 == 0) {
+        DLIST_PUSH_BACK(&l, e, el_link);
+        a[n] = e;
+      } else {
+        DLIST_PUSH_FRONT(&l, e, el_link);
+        for (r = n; r > 0; r--)
+          a[r] = a[r - 1];
+        a[0] = e;
+      }
+      n++;
+    }
+
+    // Insert around and remove random elements.
+    for (k = 0; k < 10; k++) {
+      r = rand() % n;
+      e = malloc(sizeof(elem));
+      e->el_num = rand() % 20;
+      DLIST_INSERT_BEFORE(&l, a[r], e, el_link);
+      for (int j = n; j > r; j--)
+        a[j] = a[j - 1];
+      a[r] = e;
+      n++;
+
+      r = rand() % n;
+      DLIST_REMOVE(&l, a[r], el_link, free);
+      for (int j = r; j < n - 1; j++)
+        a[j] = a[j + 1];
+      n--;
+
+      r = rand() % n;
+      e = malloc(sizeof(elem));
+      e->el_num = rand() % 20;
+      DLIST_INSERT_AFTER(&l, a[r], e, el_link);
+      for (int j = n; j > r + 1; j--)
+        a[j] = a[j - 1];
+      a[r + 1] = e;
+      n++;
+    }
+
+    if (!verify(&l, a, n)) {
+      printf("Links are inconsistent after insertion and removal.\n");
+      return EXIT_FAILURE;
+    }
+
+    // Sort the list and check the links.
+    DLIST_SORT(&l, elem, el_link, compare, NULL);
+    k = 0;
+    DLIST_FIRST(&e, &l);
+    while (e != NULL) {
+      a[k++] = e;
+      DLIST_NEXT(&e, e, el_link);
+    }
+    for (r = 1; r < k; r++) {
+      if (a[r - 1]->el_num > a[r]->el_num) {
+        printf("List is not sorted.\n");
+        return EXIT_FAILURE;
+      }
+    }
+    if (k != n || !verify(&l, a, n)) {
+      printf("Links are inconsistent after sorting.\n");
+      return EXIT_FAILURE;
+    }
+
+    // Remove the odd numbers.
+    for (r = 0, k = 0; r < n; r++)
+      if (a[r]->el_num % 2 == 0)
+        a[k++] = a[r];
+    DLIST_FILTER(&l, elem, el_link, free, is_odd, NULL);
+    if (!verify(&l, a, k)) {
+      printf("Links are inconsistent after filtering.\n");
+      return EXIT_FAILURE;
+    }
+
+    // Release the elements from both ends.
+    while (k > 0) {
+      if (rand() % 2 == 0) {
+        DLIST_POP_FRONT(&l, elem, el_link, free);
+        for (r = 0; r < k - 1; r++)
+          a[r] = a[r + 1];
+      } else {
+        DLIST_POP_BACK(&l, elem, el_link, free);
+      }
+      k--;
+      if (!verify(&l, a, k)) {
+        printf("Links are inconsistent after removal.\n");
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
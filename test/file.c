@@ -0,0 +1,223 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <time.h>
+
+#include "../list_file.h"
+
+
+/// Maximal number of elements in the list.
+#define ELEMENTS 10000
+
+/// Element.
+typedef struct _elem {
+  LIST_LINK(_elem) el_link;
+  int              el_num;
+} elem;
+
+/// List.
+typedef LIST_TYPE(_list, elem) list;
+
+/// Element of a different size.
+typedef struct _wide {
+  LIST_LINK(_wide) wd_link;
+  int              wd_num[4];
+} wide;
+
+/// List of elements of a different size.
+typedef LIST_TYPE(_wlist, wide) wlist;
+
+/// Verify that the list contains the expected numbers in the expected order.
+/// @return decision
+///
+/// @param[in] l list
+/// @param[in] v expected numbers
+/// @param[in] n number of expected numbers
+static bool
+verify(list* l, const int* v, int n)
+{
+  elem* e;
+  int k;
+
+  LIST_FIRST(&e, l);
+  for (k = 0; k < n; k++) {
+    if (e == NULL || e->el_num != v[k])
+      return false;
+
+    LIST_NEXT(&e, e, el_link);
+  }
+
+  return e == NULL;
+}
+
+/// Dump the list into a new temporary file.
+/// @return file stream
+///
+/// @param[in] l list
+static FILE*
+dump(list* l)
+{
+  FILE* f;
+  bool ok;
+
+  f = tmpfile();
+  if (f == NULL)
+    return NULL;
+
+  LIST_DUMP(&ok, l, elem, el_link, f);
+  if (!ok || fflush(f) != 0) {
+    fclose(f);
+    return NULL;
+  }
+
+  return f;
+}
+
+int
+main(void)
+{
+  static elem a[ELEMENTS];
+  static int v[ELEMENTS];
+  struct list_map p;
+  struct list_map q;
+  list l;
+  list g;
+  list h;
+  wlist w;
+  elem* e;
+  FILE* f;
+  int64_t x;
+  bool ok;
+  int i;
+  int k;
+  int m;
+
+  srand(time(NULL));
+
+  for (i = 0; i < 100; i++) {
+    m = i < 2 ? i : (rand() % (ELEMENTS - 1)) + 2;
+
+    // Create the list.
+    LIST_NEW(&l);
+    for (k = 0; k < m; k++) {
+      a[k].el_num = rand();
+      v[m - k - 1] = a[k].el_num;
+      LIST_PUSH(&l, &a[k], el_link);
+    }
+
+    f = dump(&l);
+    if (f == NULL) {
+      printf("Unable to dump the list.\n");
+      return EXIT_FAILURE;
+    }
+
+    // Load the file twice, so that the second mapping has to be relocated.
+    LIST_LOAD(&ok, &g, elem, el_link, &p, fileno(f));
+    if (!ok || !verify(&g, v, m)) {
+      printf("Loaded list does not match.\n");
+      return EXIT_FAILURE;
+    }
+
+#ifdef MAP_FIXED_NOREPLACE
+    if (p.lm_base != (void*)(uintptr_t)LIST_FILE_BASE) {
+      printf("File was not mapped at the base address.\n");
+      return EXIT_FAILURE;
+    }
+#endif
+
+    // Modify the first mapping, which must not affect the second one.
+    LIST_FIRST(&e, &g);
+    if (e != NULL)
+      e->el_num = ~v[0];
+
+    LIST_LOAD(&ok, &h, elem, el_link, &q, fileno(f));
+    if (!ok || !verify(&h, v, m) || q.lm_base == p.lm_base) {
+      printf("Relocated list does not match.\n");
+      return EXIT_FAILURE;
+    }
+
+    LIST_UNLOAD(&h, &q);
+
+    // Loading the file with a different element type must fail.
+    LIST_LOAD(&ok, &w, wide, wd_link, &q, fileno(f));
+    if (ok) {
+      printf("File was loaded with a different element type.\n");
+      return EXIT_FAILURE;
+    }
+
+    // Corrupt a link with an odd value, which is never a valid link as the
+    // elements are aligned. Loading must fail both with and without
+    // relocation.
+    if (m > 1) {
+      k = rand() % m;
+      x = rand() | 1;
+      if (pwrite(fileno(f), &x, sizeof(x), LIST_FILE_HEADER
+                 + k * sizeof(elem) + offsetof(elem, el_link)) != sizeof(x)) {
+        printf("Unable to corrupt the file.\n");
+        return EXIT_FAILURE;
+      }
+
+      LIST_LOAD(&ok, &h, elem, el_link, &q, fileno(f));
+      if (ok) {
+        printf("Relocated corrupted file was loaded.\n");
+        return EXIT_FAILURE;
+      }
+
+      LIST_UNLOAD(&g, &p);
+#if LIST_FILE_VERIFY
+      LIST_LOAD(&ok, &h, elem, el_link, &q, fileno(f));
+      if (ok) {
+        printf("Corrupted file was loaded.\n");
+        return EXIT_FAILURE;
+      }
+#endif
+    } else {
+      LIST_UNLOAD(&g, &p);
+    }
+
+    // Truncate the file, which must fail.
+    if (m > 0) {
+      if (ftruncate(fileno(f), LIST_FILE_HEADER + m * sizeof(elem) - 1) != 0) {
+        printf("Unable to truncate the file.\n");
+        return EXIT_FAILURE;
+      }
+
+      LIST_LOAD(&ok, &h, elem, el_link, &q, fileno(f));
+      if (ok) {
+        printf("Truncated file was loaded.\n");
+        return EXIT_FAILURE;
+      }
+
+      if (ftruncate(fileno(f), LIST_FILE_HEADER + (m - 1) * sizeof(elem))) {
+        printf("Unable to truncate the file.\n");
+        return EXIT_FAILURE;
+      }
+
+      LIST_LOAD(&ok, &h, elem, el_link, &q, fileno(f));
+      if (ok) {
+        printf("Shortened file was loaded.\n");
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Damage the header, which must fail.
+    x = 0;
+    if (pwrite(fileno(f), &x, sizeof(x), 0) != sizeof(x)) {
+      printf("Unable to damage the header.\n");
+      return EXIT_FAILURE;
+    }
+
+    LIST_LOAD(&ok, &h, elem, el_link, &q, fileno(f));
+    if (ok) {
+      printf("File with a damaged header was loaded.\n");
+      return EXIT_FAILURE;
+    }
+
+    fclose(f);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "../hash.h"
+
+
+/// Element.
+typedef struct _elem {
+  LIST_LINK(_elem) el_next;
+  int              el_num;
+} elem;
+
+/// Hash table.
+typedef HASH_TYPE(_hash, elem) hash;
+
+/// Compute the hash of the number stored in the element.
+/// @return hash value
+///
+/// @param[in] a element
+static size_t
+elem_hash(const elem* a)
+{
+  return (size_t)a->el_num * 2654435761u;
+}
+
+/// Determine whether two elements store the same number.
+/// @return decision
+///
+/// @param[in] a first element
+/// @param[in] b second element
+static bool
+elem_equal(const elem* a, const elem* b)
+{
+  return a->el_num == b->el_num;
+}
+
+/// Count the elements in the hash table.
+///
+/// @param[in]  a element
+/// @param[in]  i unused index of the element
+/// @param[out] c number of elements
+static void
+count(const elem* a, intmax_t i, size_t* c)
+{
+  (void)a;
+  (void)i;
+
+  *c += 1;
+}
+
+int
+main(void)
+{
+  static bool present[10000];
+  hash h;
+  elem k;
+  elem* e;
+  size_t c;
+  size_t l;
+  size_t n;
+  bool r;
+  int i;
+
+  srand(time(NULL));
+
+  HASH_NEW(&r, &h, 1);
+  if (!r) {
+    printf("Unable to create the hash table.\n");
+    return EXIT_FAILURE;
+  }
+
+  // Perform random insertions and removals.
+  n = 0;
+  for (i = 0; i < 1000000; i++) {
+    k.el_num = rand() % 10000;
+    if (rand() % 3 != 0) {
+      if (present[k.el_num])
+        continue;
+
+      e = malloc(sizeof(elem));
+      e->el_num = k.el_num;
+      HASH_INSERT(&h, elem, el_next, elem_hash, e);
+      present[k.el_num] = true;
+      n++;
+    } else {
+      HASH_REMOVE(&r, &h, elem, el_next, elem_hash, elem_equal, &k, free);
+      if (r != present[k.el_num]) {
+        printf("Removal of %d returned %d.\n", k.el_num, r);
+        return EXIT_FAILURE;
+      }
+      if (r)
+        n--;
+      present[k.el_num] = false;
+    }
+  }
+
+  // Check the presence of all numbers.
+  for (i = 0; i < 10000; i++) {
+    k.el_num = i;
+    HASH_FIND(&e, &h, elem, el_next, elem_hash, elem_equal, &k);
+    if ((e != NULL) != present[i] || (e != NULL && e->el_num != i)) {
+      printf("Lookup of %d is incorrect.\n", i);
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Check the number of elements.
+  c = 0;
+  HASH_MAP(&h, elem, el_next, count, &c);
+  HASH_LENGTH(&l, &h);
+  if (c != n || l != n) {
+    printf("Length does not match, got: %zu, expected: %zu\n", c, n);
+    return EXIT_FAILURE;
+  }
+
+  HASH_FREE(&h, elem, el_next, free);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "../heap.h"
+
+
+/// Element.
+typedef struct _elem {
+  HEAP_LINK(_elem) el_link;
+  int              el_num;
+  bool             el_live;
+} elem;
+
+/// Heap.
+typedef HEAP_TYPE(_heap, elem) heap;
+
+/// Compare two elements by the numerical value they store.
+/// @return comparison result
+/// @retval  0 a and b equal
+/// @retval  1 a is greater
+/// @retval -1 b is greater
+///
+/// @param[in] a first element
+/// @param[in] b second element
+/// @param[in] p unused payload pointer
+static int
+compare(const elem* a, const elem* b, void* p)
+{
+  (void)p;
+
+  if (a->el_num == b->el_num)
+    return 0;
+
+  if (a->el_num > b->el_num)
+    return 1;
+  else
+    return -1;
+}
+
+/// Mark the element as removed from the heap.
+///
+/// @param[in] a element
+static void
+release(elem* a)
+{
+  a->el_live = false;
+}
+
+int
+main(void)
+{
+  static elem a[1000];
+  heap h;
+  heap g;
+  elem* e;
+  elem* f;
+  int i;
+  int k;
+  int m;
+  int n;
+  bool empty;
+
+  srand(time(NULL));
+
+  for (i = 0; i < 10000; i++) {
+    m = (rand() % 1000) + 1;
+
+    // Split the elements into two heaps and meld them.
+    HEAP_NEW(&h);
+    HEAP_NEW(&g);
+    for (k = 0; k < m; k++) {
+      a[k].el_num = rand() % 1000;
+      a[k].el_live = true;
+      if (k % 2 == 0)
+        HEAP_PUSH(&h, elem, el_link, &a[k], compare, NULL);
+      else
+        HEAP_PUSH(&g, elem, el_link, &a[k], compare, NULL);
+    }
+    HEAP_MELD(&h, &g, elem, el_link, compare, NULL);
+    HEAP_EMPTY(&empty, &g);
+    if (!empty) {
+      printf("Melded heap is not empty.\n");
+      return EXIT_FAILURE;
+    }
+
+    // Remove a few elements and decrease the keys of others.
+    n = m;
+    for (k = 0; k < m / 4; k++) {
+      e = &a[rand() % m];
+      if (!e->el_live)
+        continue;
+
+      if (rand() % 2 == 0) {
+        HEAP_REMOVE(&h, elem, el_link, e, release, compare, NULL);
+        n--;
+      } else {
+        e->el_num -= rand() % 1000;
+        HEAP_DECREASE(&h, elem, el_link, e, compare, NULL);
+      }
+    }
+
+    // Pop all elements and verify their order.
+    f = NULL;
+    for (k = 0; k < n; k++) {
+      HEAP_MIN(&e, &h);
+      if (e == NULL || !e->el_live || (f != NULL && f->el_num > e->el_num)) {
+        printf("Heap order is violated.\n");
+        return EXIT_FAILURE;
+      }
+
+      HEAP_POP(&h, elem, el_link, release, compare, NULL);
+      f = e;
+    }
+
+    HEAP_EMPTY(&empty, &h);
+    if (!empty) {
+      printf("Heap is not empty after removing all elements.\n");
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "../list.h"
+
+
+/// Element.
+typedef struct _elem {
+  LIST_LINK(_elem) el_next;
+  int              el_num;
+} elem;
+
+/// List.
+typedef LIST_TYPE(_list, elem) list;
+
+/// Positional index.
+typedef LIST_INDEX_TYPE(_index, elem) lindex;
+
+/// Verify that the positional index agrees with the plain traversal for all
+/// positions, including the ones past the end of the list.
+/// @return decision
+///
+/// @param[in] x positional index
+/// @param[in] l list
+/// @param[in] v expected numbers
+/// @param[in] n number of expected numbers
+static bool
+verify(lindex* x, list* l, const int* v, int n)
+{
+  elem* e;
+  elem* f;
+  int k;
+
+  for (k = 0; k < n + 3; k++) {
+    LIST_INDEX_NTH(&e, x, l, elem, el_next, k);
+    LIST_NTH(&f, l, elem, el_next, k);
+    if (e != f || (k < n && (e == NULL || e->el_num != v[k]))
+               || (k >= n && e != NULL))
+      return false;
+  }
+
+  return true;
+}
+
+int
+main(void)
+{
+  static int v[1000];
+  lindex x;
+  list l;
+  elem* e;
+  int i;
+  int j;
+  int k;
+  int m;
+  int s;
+
+  srand(time(NULL));
+
+  for (i = 0; i < 10000; i++) {
+    m = rand() % 300;
+    s = (rand() % 10) + 1;
+
+    LIST_NEW(&l);
+    for (k = m - 1; k >= 0; k--) {
+      e = malloc(sizeof(elem));
+      e->el_num = k;
+      v[k] = k;
+      LIST_PUSH(&l, e, el_next);
+    }
+
+    LIST_INDEX_NEW(&x, s);
+    if (!verify(&x, &l, v, m)) {
+      printf("Positional index does not match the list.\n");
+      return EXIT_FAILURE;
+    }
+
+    // Drop elements, both at and between the checkpoints.
+    j = (rand() % 2 == 0) ? s * (rand() % 10) : rand() % 50;
+    LIST_INDEX_DROP(&x, &l, elem, el_next, j, free);
+    j = j < m ? j : m;
+    for (k = 0; k + j < m; k++)
+      v[k] = v[k + j];
+    m -= j;
+    if (!verify(&x, &l, v, m)) {
+      printf("Positional index does not match the list after drop.\n");
+      return EXIT_FAILURE;
+    }
+
+    // Take elements.
+    j = rand() % 300;
+    LIST_INDEX_TAKE(&x, &l, elem, el_next, j, free);
+    m = j < m ? j : m;
+    if (!verify(&x, &l, v, m)) {
+      printf("Positional index does not match the list after take.\n");
+      return EXIT_FAILURE;
+    }
+
+    // Modify the list directly and invalidate the index.
+    e = malloc(sizeof(elem));
+    e->el_num = -1;
+    LIST_PUSH(&l, e, el_next);
+    for (k = m; k > 0; k--)
+      v[k] = v[k - 1];
+    v[0] = -1;
+    m++;
+    LIST_INDEX_INVALIDATE(&x);
+    if (!verify(&x, &l, v, m)) {
+      printf("Positional index does not match the list after update.\n");
+      return EXIT_FAILURE;
+    }
+
+    // Release the index and use it again.
+    LIST_INDEX_FREE(&x);
+    if (x._list_stp != s || !verify(&x, &l, v, m)) {
+      printf("Released positional index cannot be used again.\n");
+      return EXIT_FAILURE;
+    }
+
+    LIST_INDEX_FREE(&x);
+    LIST_FREE(&l, elem, el_next, free);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,233 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "../list.h"
+
+
+/// Element.
+typedef struct _elem {
+  LIST_LINK(_elem) el_next;
+  int              el_num;
+} elem;
+
+/// List.
+typedef LIST_TYPE(_list, elem) list;
+
+/// Compare two elements by the numerical value they store.
+/// @return comparison result
+/// @retval  0 a and b equal
+/// @retval  1 a is greater
+/// @retval -1 b is greater
+///
+/// @param[in] a first element
+/// @param[in] b second element
+/// @param[in] p unused payload pointer
+static int
+compare(const elem* a, const elem* b, void* p)
+{
+  (void)p;
+
+  if (a->el_num == b->el_num)
+    return 0;
+
+  if (a->el_num > b->el_num)
+    return 1;
+  else
+    return -1;
+}
+
+/// Type-specialised list functions.
+LIST_GENERATE(elist, list, elem, el_next, compare)
+
+/// Number of released elements.
+static int released;
+
+/// Release the element.
+///
+/// @param[in] a element
+static void
+release(elem* a)
+{
+  released++;
+  free(a);
+}
+
+/// Release the element through an untyped pointer.
+///
+/// @param[in] a element
+static void
+release_any(void* a)
+{
+  release(a);
+}
+
+/// Determine whether the number stored in the element is odd.
+/// @return decision
+///
+/// @param[in] a element
+/// @param[in] i unused index of the element
+/// @param[in] p unused payload pointer
+static bool
+is_odd(const elem* a, intmax_t i, void* p)
+{
+  (void)i;
+  (void)p;
+
+  return (a->el_num % 2) != 0;
+}
+
+/// Create a list that contains the given numbers in the given order.
+///
+/// @param[in] l list
+/// @param[in] v numbers
+/// @param[in] n number of numbers
+static void
+create(list* l, const int* v, int n)
+{
+  elem* e;
+  int k;
+
+  LIST_NEW(l);
+  for (k = n - 1; k >= 0; k--) {
+    e = malloc(sizeof(elem));
+    e->el_num = v[k];
+    LIST_PUSH(l, e, el_next);
+  }
+}
+
+/// Verify that the list contains the given numbers in the given order.
+/// @return decision
+///
+/// @param[in] l list
+/// @param[in] v numbers
+/// @param[in] n number of numbers
+static bool
+verify(list* l, const int* v, int n)
+{
+  elem* e;
+  int k;
+
+  LIST_FIRST(&e, l);
+  for (k = 0; k < n; k++) {
+    if (e == NULL || e->el_num != v[k])
+      return false;
+
+    LIST_NEXT(&e, e, el_next);
+  }
+
+  return e == NULL;
+}
+
+int
+main(void)
+{
+  static int v[1000];
+  static int u[1000];
+  static int w[1000];
+  static bool seen[20];
+  list l;
+  elem key;
+  elem* e;
+  int lo;
+  int hi;
+  int i;
+  int k;
+  int j;
+  int m;
+  int n;
+
+  srand(time(NULL));
+
+  for (i = 0; i < 10000; i++) {
+    // Generate runs of duplicate numbers, including at the tail.
+    m = 0;
+    while (m < 900 && (m == 0 || rand() % 50 != 0)) {
+      n = (rand() % 5) + 1;
+      j = rand() % 20;
+      for (k = 0; k < n; k++)
+        v[m++] = j;
+    }
+    if (rand() % 2 == 0)
+      for (k = 0; k < 3; k++, m++)
+        v[m] = v[m - 1];
+
+    // Compute the expected result.
+    n = 0;
+    for (k = 0; k < 20; k++)
+      seen[k] = false;
+    for (k = 0; k < m; k++) {
+      if (!seen[v[k]])
+        u[n++] = v[k];
+      seen[v[k]] = true;
+    }
+
+    // Remove the duplicates, alternating between the macro and the generated
+    // function.
+    create(&l, v, m);
+    released = 0;
+    if (i % 2 == 0)
+      LIST_UNIQUE(&l, elem, el_next, release, compare, NULL);
+    else
+      elist_unique(&l, release_any, NULL);
+    if (!verify(&l, u, n) || released != m - n) {
+      printf("Duplicate elements were not removed.\n");
+      return EXIT_FAILURE;
+    }
+
+    // Verify the generated query functions.
+    lo = u[0];
+    hi = u[0];
+    for (k = 0; k < n; k++) {
+      lo = u[k] < lo ? u[k] : lo;
+      hi = u[k] > hi ? u[k] : hi;
+    }
+
+    if (elist_length(&l) != n
+        || elist_min(&l, NULL)->el_num != lo
+        || elist_max(&l, NULL)->el_num != hi) {
+      printf("Length, minimum or maximum do not match.\n");
+      return EXIT_FAILURE;
+    }
+
+    for (k = 0; k < 20; k++) {
+      key.el_num = k;
+      e = elist_find(&l, &key, NULL);
+      if ((e == NULL) == seen[k] || (e != NULL && e->el_num != k)) {
+        printf("Element %d was not found.\n", k);
+        return EXIT_FAILURE;
+      }
+    }
+
+    LIST_NTH(&e, &l, elem, el_next, rand() % n);
+    if (!elist_member(&l, e) || elist_member(&l, &key)) {
+      printf("Membership does not match.\n");
+      return EXIT_FAILURE;
+    }
+
+    // Verify the generated modifying functions.
+    for (k = 0; k < n; k++)
+      w[k] = u[n - k - 1];
+    elist_reverse(&l);
+    if (!verify(&l, w, n)) {
+      printf("List was not reversed.\n");
+      return EXIT_FAILURE;
+    }
+
+    j = 0;
+    for (k = 0; k < n; k++)
+      if (w[k] % 2 == 0)
+        w[j++] = w[k];
+    released = 0;
+    elist_filter(&l, release_any, is_odd, NULL);
+    if (!verify(&l, w, j) || released != n - j) {
+      printf("List was not filtered.\n");
+      return EXIT_FAILURE;
+    }
+
+    LIST_FREE(&l, elem, el_next, free);
+  }
+
+  return EXIT_SUCCESS;
+}
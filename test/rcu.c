@@ -0,0 +1,183 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "../list_rcu.h"
+
+
+/// Number of reader threads.
+#define READERS 4
+
+/// Number of writer operations.
+#define OPERATIONS 200000
+
+/// Range of the element keys.
+#define KEYS 256
+
+/// Element.
+typedef struct _elem {
+  LIST_RCU_LINK(_elem) el_link;
+  int                  el_key;
+  bool                 el_dead;
+  struct _elem*        el_grave;
+} elem;
+
+/// List.
+typedef LIST_TYPE(_list, elem) list;
+
+/// Reclamation domain.
+typedef LIST_EPOCH_TYPE(_domain, elem) domain;
+
+/// Shared state of the test.
+static list     l;
+static domain   d;
+static bool     done;
+static bool     fail;
+static elem*    grave;
+static intmax_t buried;
+
+/// Mark the element as reclaimed and keep it for a later release, so that a
+/// reader that reaches it can detect the violation.
+///
+/// @param[in] a element
+static void
+bury(elem* a)
+{
+  __atomic_store_n(&a->el_dead, true, __ATOMIC_RELAXED);
+  a->el_grave = grave;
+  grave = a;
+  buried++;
+}
+
+/// Determine whether the element has the given key.
+/// @return decision
+///
+/// @param[in] a element
+/// @param[in] k key
+static bool
+has_key(const elem* a, int k)
+{
+  return a->el_key == k;
+}
+
+/// Verify that the element was not reclaimed.
+///
+/// @param[in] a element
+/// @param[in] i unused index of the element
+/// @param[in] p unused payload pointer
+static void
+check(elem* a, intmax_t i, void* p)
+{
+  (void)i;
+  (void)p;
+
+  if (__atomic_load_n(&a->el_dead, __ATOMIC_RELAXED))
+    __atomic_store_n(&fail, true, __ATOMIC_RELAXED);
+}
+
+/// Repeatedly search and traverse the list.
+/// @return NULL
+///
+/// @param[in] arg reader slot index
+static void*
+reader(void* arg)
+{
+  size_t s = (size_t)(uintptr_t)arg;
+  uint32_t x = (uint32_t)s * 2654435761u + 1;
+  elem* e;
+
+  while (!__atomic_load_n(&done, __ATOMIC_RELAXED)) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    LIST_EPOCH_ENTER(&d, s);
+    LIST_RCU_FIND(&e, &l, elem, el_link, has_key, (int)(x % KEYS));
+    if (e != NULL)
+      check(e, 0, NULL);
+    LIST_RCU_MAP(&l, elem, el_link, check, NULL);
+    LIST_EPOCH_EXIT(&d, s);
+  }
+
+  return NULL;
+}
+
+int
+main(void)
+{
+  pthread_t t[READERS];
+  elem* e;
+  elem* f;
+  bool ok;
+  int i;
+  int k;
+  int n;
+
+  srand(time(NULL));
+
+  LIST_NEW(&l);
+  LIST_EPOCH_NEW(&ok, &d, READERS);
+  if (!ok) {
+    printf("Unable to create the reclamation domain.\n");
+    return EXIT_FAILURE;
+  }
+
+  for (i = 0; i < READERS; i++)
+    pthread_create(&t[i], NULL, reader, (void*)(uintptr_t)i);
+
+  // Push, insert and remove elements, reclaiming them along the way.
+  n = 0;
+  for (i = 0; i < OPERATIONS; i++) {
+    k = rand() % 3;
+    if (k == 0 || n < 16) {
+      e = malloc(sizeof(elem));
+      e->el_key = rand() % KEYS;
+      e->el_dead = false;
+      LIST_FIRST(&f, &l);
+      if (f != NULL && rand() % 2 == 0)
+        LIST_RCU_INSERT(f, e, el_link);
+      else
+        LIST_RCU_PUSH(&l, e, el_link);
+      n++;
+    } else if (k == 1) {
+      LIST_RCU_POP(&l, elem, el_link, &d);
+      n--;
+    } else {
+      LIST_NTH(&f, &l, elem, el_link, rand() % (n - 1));
+      LIST_RCU_REMOVE(f, elem, el_link, &d);
+      n--;
+    }
+
+    if (i % 16 == 0)
+      LIST_EPOCH_RECLAIM(&d, elem, el_link, bury);
+  }
+
+  __atomic_store_n(&done, true, __ATOMIC_RELAXED);
+  for (i = 0; i < READERS; i++)
+    pthread_join(t[i], NULL);
+
+  if (fail) {
+    printf("Reader reached a reclaimed element.\n");
+    return EXIT_FAILURE;
+  }
+
+  if (buried == 0) {
+    printf("No element was reclaimed.\n");
+    return EXIT_FAILURE;
+  }
+
+  // Release all elements.
+  while (n-- > 0)
+    LIST_RCU_POP(&l, elem, el_link, &d);
+  LIST_EPOCH_FREE(&d, elem, el_link, bury);
+  while (grave != NULL) {
+    e = grave;
+    grave = e->el_grave;
+    free(e);
+  }
+
+  return EXIT_SUCCESS;
+}
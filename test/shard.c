@@ -0,0 +1,138 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "../list_shard.h"
+
+
+/// Number of producer threads.
+#define PRODUCERS 4
+
+/// Number of elements pushed by each producer.
+#define ELEMENTS 100000
+
+/// Element.
+typedef struct _elem {
+  LIST_LINK(_elem) el_link;
+  int              el_id;
+} elem;
+
+/// List.
+typedef LIST_TYPE(_list, elem) list;
+
+/// Sharded list.
+typedef LIST_SHARD_TYPE(_shard, elem) shard;
+
+/// Shared state of the test.
+static shard s;
+static elem  a[PRODUCERS * ELEMENTS];
+static bool  done[PRODUCERS];
+
+/// Push elements, mostly to the own shard and occasionally to a shared one.
+/// @return NULL
+///
+/// @param[in] arg producer index
+static void*
+producer(void* arg)
+{
+  size_t p = (size_t)(uintptr_t)arg;
+
+  for (int k = 0; k < ELEMENTS; k++) {
+    a[p * ELEMENTS + k].el_id = (int)(p * ELEMENTS + k);
+    LIST_SHARD_PUSH(&s, elem, el_link, k % 8 == 0 ? 0 : p,
+                    &a[p * ELEMENTS + k]);
+  }
+
+  __atomic_store_n(&done[p], true, __ATOMIC_RELEASE);
+  return NULL;
+}
+
+/// Count the elements of the list and mark them as seen.
+/// @return number of elements or -1 if an element was seen before
+///
+/// @param[in] l    list
+/// @param[in] seen flags of seen elements
+static intmax_t
+consume(list* l, bool* seen)
+{
+  intmax_t n = 0;
+  elem* e;
+
+  LIST_FIRST(&e, l);
+  while (e != NULL) {
+    if (seen[e->el_id])
+      return -1;
+
+    seen[e->el_id] = true;
+    n++;
+    LIST_NEXT(&e, e, el_link);
+  }
+
+  LIST_NEW(l);
+  return n;
+}
+
+int
+main(void)
+{
+  static bool seen[PRODUCERS * ELEMENTS];
+  pthread_t t[PRODUCERS];
+  intmax_t n;
+  intmax_t c;
+  intmax_t m;
+  list l;
+  bool ok;
+  bool busy;
+  int i;
+
+  LIST_SHARD_NEW(&ok, &s, 0);
+  if (ok) {
+    printf("Sharded list without shards was created.\n");
+    return EXIT_FAILURE;
+  }
+  LIST_SHARD_FREE(&s, elem, el_link, free);
+
+  LIST_SHARD_NEW(&ok, &s, PRODUCERS);
+  if (!ok) {
+    printf("Unable to create the sharded list.\n");
+    return EXIT_FAILURE;
+  }
+
+  for (i = 0; i < PRODUCERS; i++)
+    pthread_create(&t[i], NULL, producer, (void*)(uintptr_t)i);
+
+  // Drain the shards while the producers are active.
+  LIST_NEW(&l);
+  n = 0;
+  do {
+    busy = false;
+    for (i = 0; i < PRODUCERS; i++)
+      busy |= !__atomic_load_n(&done[i], __ATOMIC_ACQUIRE);
+
+    LIST_SHARD_LENGTH(&m, &s);
+    LIST_SHARD_DRAIN(&s, &l, elem, el_link);
+    c = consume(&l, seen);
+    if (m < 0 || c < 0) {
+      printf("Negative length or duplicate element.\n");
+      return EXIT_FAILURE;
+    }
+    n += c;
+  } while (busy);
+
+  for (i = 0; i < PRODUCERS; i++)
+    pthread_join(t[i], NULL);
+
+  LIST_SHARD_DRAIN(&s, &l, elem, el_link);
+  c = consume(&l, seen);
+  LIST_SHARD_LENGTH(&m, &s);
+  if (c < 0 || n + c != PRODUCERS * ELEMENTS || m != 0) {
+    printf("Drained %jd elements, expected %d.\n", n + c,
+           PRODUCERS * ELEMENTS);
+    return EXIT_FAILURE;
+  }
+
+  LIST_SHARD_FREE(&s, elem, el_link, free);
+  return EXIT_SUCCESS;
+}
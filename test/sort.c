@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <limits.h>
 #include <time.h>
 
 #include "../list.h"
@@ -15,6 +16,9 @@ typedef struct _elem {
 /// List.
 typedef LIST_TYPE(_list, elem) list;
 
+/// Incremental sort state.
+typedef LIST_SORT_STATE(_sort, elem) sort;
+
 /// Compare two elements by the numerical value they store.
 /// @return comparison result
 /// @retval  0 a and b equal
@@ -38,6 +42,9 @@ compare(const elem* a, const elem* b, void* p)
     return -1;
 }
 
+/// Type-specialised list functions.
+LIST_GENERATE(elist, list, elem, el_next, compare)
+
 /// Print the numerical value stored in the element to the standard output
 /// stream, followed either by a comma or a new-line character.
 ///
@@ -80,7 +87,10 @@ int
 main(void)
 {
   list l;
+  list b;
+  sort s;
   elem* e;
+  elem* h;
   int i;
   int k;
   int m;
@@ -100,8 +110,51 @@ main(void)
       LIST_PUSH(&l, e, el_next);
     }
 
-    // Sort.
-    LIST_SORT(&l, elem, el_next, compare, NULL);
+    // Sort, alternating between the macro, the generated function and the
+    // incremental sort with a random budget (including non-positive ones),
+    // which is occasionally ended before the sorting is finished.
+    if (i % 3 == 0) {
+      LIST_SORT(&l, elem, el_next, compare, NULL);
+    } else if (i % 3 == 1) {
+      elist_sort(&l, NULL);
+    } else {
+      LIST_SORT_BEGIN(&s, &l, elem, el_next);
+      k = rand() % 2 == 0 ? INT_MAX : rand() % 50;
+      do {
+        LIST_SORT_STEP(&r, &s, elem, el_next, (rand() % 17) - 1, compare, NULL);
+      } while (!r && k-- > 0);
+      LIST_SORT_END(&s, &l, elem, el_next, compare, NULL);
+    }
+
+    // Insert a batch of elements into the sorted list, alternating between
+    // the macro and the generated function.
+    LIST_NEW(&b);
+    n = rand() % 20;
+    for (k = 0; k < n; k++) {
+      e = malloc(sizeof(elem));
+      e->el_num = rand() % 20;
+      LIST_PUSH(&b, e, el_next);
+    }
+    if (i % 2 == 0)
+      LIST_INSERT_SORTED_BATCH(&l, elem, el_next, &b, compare, NULL);
+    else
+      elist_insert_sorted_batch(&l, &b, NULL);
+    m += n;
+
+    // Insert single elements into the sorted list, mostly in an ascending
+    // order so that the hint is used, alternating between the macro and the
+    // generated function.
+    h = NULL;
+    n = rand() % 20;
+    for (k = 0; k < n; k++) {
+      e = malloc(sizeof(elem));
+      e->el_num = (rand() % 4 == 0) ? rand() % 20 : k;
+      if (i % 2 == 0)
+        LIST_INSERT_SORTED(&l, elem, el_next, &h, e, compare, NULL);
+      else
+        elist_insert_sorted(&l, &h, e, NULL);
+    }
+    m += n;
 
     // Check the result correctness.
     r = true;
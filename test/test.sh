@@ -13,6 +13,28 @@ function run_test {
 
 # Compile the test programs
 cc -Wall -Wextra -std=c99 -O3 sort.c -o test_sort
+cc -Wall -Wextra -std=c99 -O3 list.c -o test_list
+cc -Wall -Wextra -std=c99 -O3 index.c -o test_index
+cc -Wall -Wextra -std=c99 -O3 dlist.c -o test_dlist
+cc -Wall -Wextra -std=c99 -O3 hash.c -o test_hash
+cc -Wall -Wextra -std=c99 -O3 heap.c -o test_heap
+cc -Wall -Wextra -std=c99 -O3 wheel.c -o test_wheel
+cc -Wall -Wextra -std=c99 -O3 bloom.c -o test_bloom
+cc -Wall -Wextra -std=c99 -O3 compact.c -o test_compact
+cc -Wall -Wextra -std=c99 -O3 file.c -o test_file
+cc -Wall -Wextra -std=c99 -O3 -pthread rcu.c -o test_rcu
+cc -Wall -Wextra -std=c99 -O3 -pthread shard.c -o test_shard
 
 # Run the test programs
 run_test "sort" test_sort
+run_test "list" test_list
+run_test "index" test_index
+run_test "dlist" test_dlist
+run_test "hash" test_hash
+run_test "heap" test_heap
+run_test "wheel" test_wheel
+run_test "bloom" test_bloom
+run_test "compact" test_compact
+run_test "file" test_file
+run_test "rcu" test_rcu
+run_test "shard" test_shard
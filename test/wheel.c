@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+
+// Use a small wheel so that the timers overflow its range.
+#define WHEEL_BITS   3
+#define WHEEL_LEVELS 3
+
+#include "../wheel.h"
+
+
+/// Timer.
+typedef struct _timer {
+  WHEEL_LINK(_timer) tm_link;
+  uint64_t           tm_exp;
+  bool               tm_armed;
+  bool               tm_fired;
+} timer;
+
+/// Timing wheel.
+typedef WHEEL_TYPE(_wheel, timer) wheel;
+
+/// List of expired timers.
+typedef DLIST_TYPE(_ready, timer) ready;
+
+/// Mark the timer as fired.
+///
+/// @param[in] t timer
+static void
+fire(timer* t)
+{
+  t->tm_fired = true;
+}
+
+int
+main(void)
+{
+  static timer t[1000];
+  wheel w;
+  ready r;
+  timer* e;
+  uint64_t now;
+  uint64_t end;
+  int i;
+  int k;
+
+  srand(time(NULL));
+
+  for (i = 0; i < 100; i++) {
+    WHEEL_NEW(&w, rand() % 5000);
+    WHEEL_NOW(&now, &w);
+    DLIST_NEW(&r);
+    end = now + 2001;
+
+    // Arm all timers, some of them repeatedly.
+    for (k = 0; k < 1000; k++) {
+      WHEEL_IDLE(&t[k], tm_link);
+      t[k].tm_exp = now + 1 + rand() % 2000;
+      t[k].tm_armed = true;
+      t[k].tm_fired = false;
+      WHEEL_ARM(&w, tm_link, &t[k], t[k].tm_exp);
+      if (rand() % 4 == 0) {
+        t[k].tm_exp = now + 1 + rand() % 2000;
+        WHEEL_ARM(&w, tm_link, &t[k], t[k].tm_exp);
+      }
+    }
+
+    // Advance the wheel, cancelling random timers along the way.
+    while (now < end) {
+      k = rand() % 1000;
+      if (rand() % 8 == 0) {
+        WHEEL_CANCEL(&w, tm_link, &t[k]);
+        t[k].tm_armed = false;
+      }
+
+      WHEEL_TICK(&w, timer, tm_link, &r);
+      WHEEL_NOW(&now, &w);
+
+      // Verify that the expired timers fired at the right time.
+      while (true) {
+        DLIST_FIRST(&e, &r);
+        if (e == NULL)
+          break;
+
+        if (!e->tm_armed || e->tm_fired || e->tm_exp != now) {
+          printf("Timer expired at %llu, expected %llu.\n",
+                 (unsigned long long)now, (unsigned long long)e->tm_exp);
+          return EXIT_FAILURE;
+        }
+
+        DLIST_REMOVE(&r, e, tm_link, fire);
+
+        // Re-arm some of the timers once they left the ready list.
+        if (rand() % 4 == 0 && now + 100 < end) {
+          e->tm_exp = now + 1 + rand() % 100;
+          e->tm_fired = false;
+          WHEEL_ARM(&w, tm_link, e, e->tm_exp);
+        }
+      }
+    }
+
+    // Verify that all armed timers fired.
+    for (k = 0; k < 1000; k++) {
+      if (t[k].tm_armed && !t[k].tm_fired) {
+        printf("Timer set to expire at %llu did not fire.\n",
+               (unsigned long long)t[k].tm_exp);
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,217 @@
+// Copyright (c) 2017-2019 Daniel Lovasko
+// All Rights Reserved
+//
+// Distributed under the terms of the 2-clause BSD License. The full
+// license is in the file LICENSE, distributed as part of this software.
+
+#ifndef WHEEL_H
+#define WHEEL_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "dlist.h"
+
+
+///////////////////////////////////////
+// Function      // Time complexity  //
+///////////////////////////////////////
+// WHEEL_LINK    // compile time     //
+// WHEEL_TYPE    // compile time     //
+// WHEEL_NEW     // O(1)             //
+// WHEEL_NOW     // O(1)             //
+// WHEEL_ARM     // O(1)             //
+// WHEEL_CANCEL  // O(1)             //
+// WHEEL_TICK    // O(1) amortised   //
+// WHEEL_ADVANCE // O(t) amortised   //
+///////////////////////////////////////
+
+// The timing wheel consists of WHEEL_LEVELS levels of WHEEL_SLOTS slots each,
+// where a slot is a doubly linked list of timers. A slot at level l covers
+// WHEEL_SLOTS^l consecutive ticks. A timer is placed at the lowest level that
+// can represent its expiry time, and is moved to a lower level once the wheel
+// reaches the range covered by its slot. Timers that expire further in the
+// future than the wheel can represent are parked at the highest level and
+// re-placed when their slot is reached.
+//
+// Each timer is moved between levels at most WHEEL_LEVELS - 1 times, which
+// makes the expiry O(1) amortised per timer. As the slots are doubly linked,
+// a timer can be cancelled in O(1). Expired timers are appended to a ready
+// list, which is an ordinary DLIST of the timer type.
+
+/// Number of bits of the expiry time resolved by one level of the wheel.
+#ifndef WHEEL_BITS
+  #define WHEEL_BITS 6
+#endif
+
+/// Number of levels of the wheel.
+#ifndef WHEEL_LEVELS
+  #define WHEEL_LEVELS 4
+#endif
+
+/// Number of slots on each level of the wheel.
+#define WHEEL_SLOTS (1 << WHEEL_BITS)
+
+/// Definition of a new timer link.
+///
+/// @param[in] tag struct tag name
+#define WHEEL_LINK(tag)    \
+  struct {                 \
+    struct tag* _list_nxt; \
+    struct tag* _list_prv; \
+    uint64_t    _whl_exp;  \
+    int         _whl_lvl;  \
+    int         _whl_idx;  \
+  }
+
+/// Definition of a new timing wheel type.
+///
+/// @param[in] tag  struct tag name
+/// @param[in] type timer type
+#define WHEEL_TYPE(tag, type)                         \
+  struct tag {                                        \
+    struct {                                          \
+      type* _list_fst;                                \
+      type* _list_lst;                                \
+    } _whl_slt[WHEEL_LEVELS][WHEEL_SLOTS];            \
+    uint64_t _whl_now;                                \
+  }
+
+/// Internal function to place an armed timer into the appropriate slot.
+/// Please note that this function is for internal use only and should not be
+/// used in your code.
+///
+/// @param[in] wheel timing wheel
+/// @param[in] elem  timer
+/// @param[in] link  timer link name
+#define _WHEEL_PLACE(wheel, elem, link)                                 \
+  do {                                                                  \
+    uint64_t _whl_pd = (elem)->link._whl_exp - (wheel)->_whl_now;       \
+    uint64_t _whl_pe = (elem)->link._whl_exp;                           \
+    int _whl_pl = 0;                                                    \
+    while (_whl_pl < WHEEL_LEVELS - 1                                   \
+           && _whl_pd >= (UINT64_C(1) << (WHEEL_BITS * (_whl_pl + 1)))) \
+      _whl_pl++;                                                        \
+    if (_whl_pd >= (UINT64_C(1) << (WHEEL_BITS * WHEEL_LEVELS)))        \
+      _whl_pe = (wheel)->_whl_now                                       \
+             + (UINT64_C(1) << (WHEEL_BITS * WHEEL_LEVELS)) - 1;        \
+    (elem)->link._whl_lvl = _whl_pl;                                    \
+    (elem)->link._whl_idx = (int)((_whl_pe >> (WHEEL_BITS * _whl_pl))   \
+                                  & (WHEEL_SLOTS - 1));                 \
+    DLIST_PUSH_BACK(&(wheel)->_whl_slt[_whl_pl][(elem)->link._whl_idx], \
+                    elem, link);                                        \
+  } while (0)
+
+/// Initialise the timing wheel.
+///
+/// @param[in] wheel timing wheel
+/// @param[in] now   current time in ticks
+#define WHEEL_NEW(wheel, now)                                     \
+  do {                                                            \
+    for (int _whl_l = 0; _whl_l < WHEEL_LEVELS; _whl_l++)         \
+      for (int _whl_i = 0; _whl_i < WHEEL_SLOTS; _whl_i++)        \
+        DLIST_NEW(&(wheel)->_whl_slt[_whl_l][_whl_i]);            \
+    (wheel)->_whl_now = (uint64_t)(now);                          \
+  } while (0)
+
+/// Obtain the current time of the timing wheel.
+///
+/// @param[out] out   current time in ticks
+/// @param[in]  wheel timing wheel
+#define WHEEL_NOW(out, wheel)       \
+  do {                              \
+    *(out) = (wheel)->_whl_now;     \
+  } while (0)
+
+/// Arm a timer to expire at the given time. A timer that is already armed is
+/// re-armed, and an expiry time that is not in the future is treated as the
+/// next tick. Timers must be initialised by WHEEL_IDLE before they are armed
+/// for the first time. An expired timer that is still on the ready list must
+/// be removed from it, e.g. by DLIST_REMOVE, before it is armed again.
+///
+/// @param[in] wheel  timing wheel
+/// @param[in] link   timer link name
+/// @param[in] elem   timer
+/// @param[in] expiry expiry time in ticks
+#define WHEEL_ARM(wheel, link, elem, expiry)                                \
+  do {                                                                      \
+    WHEEL_CANCEL(wheel, link, elem);                                        \
+    (elem)->link._whl_exp = (uint64_t)(expiry);                             \
+    if ((elem)->link._whl_exp <= (wheel)->_whl_now)                         \
+      (elem)->link._whl_exp = (wheel)->_whl_now + 1;                        \
+    _WHEEL_PLACE(wheel, elem, link);                                        \
+  } while (0)
+
+/// Cancel a timer. Cancelling a timer that is not armed, including an expired
+/// timer on the ready list, has no effect.
+///
+/// @param[in] wheel timing wheel
+/// @param[in] link  timer link name
+/// @param[in] elem  timer
+#define WHEEL_CANCEL(wheel, link, elem)                                     \
+  do {                                                                      \
+    if ((elem)->link._whl_lvl < 0)                                          \
+      break;                                                                \
+    _DLIST_UNLINK(&(wheel)->_whl_slt[(elem)->link._whl_lvl]                 \
+                                    [(elem)->link._whl_idx], elem, link);   \
+    (elem)->link._whl_lvl = -1;                                             \
+  } while (0)
+
+/// Mark a timer as not armed.
+///
+/// @param[in] elem timer
+/// @param[in] link timer link name
+#define WHEEL_IDLE(elem, link)        \
+  do {                                \
+    (elem)->link._whl_lvl = -1;       \
+  } while (0)
+
+/// Advance the timing wheel by one tick and move the expired timers to the
+/// tail of the ready list.
+///
+/// @param[in] wheel timing wheel
+/// @param[in] type  timer C type name
+/// @param[in] link  timer link name
+/// @param[in] ready ready list
+#define WHEEL_TICK(wheel, type, link, ready)                                \
+  do {                                                                      \
+    type* _whl_e;                                                           \
+    type* _whl_n;                                                           \
+    int _whl_i;                                                             \
+    (wheel)->_whl_now++;                                                    \
+    for (int _whl_l = WHEEL_LEVELS - 1; _whl_l > 0; _whl_l--) {             \
+      if (((wheel)->_whl_now                                                \
+           & ((UINT64_C(1) << (WHEEL_BITS * _whl_l)) - 1)) != 0)            \
+        continue;                                                           \
+      _whl_i = (int)(((wheel)->_whl_now >> (WHEEL_BITS * _whl_l))           \
+                     & (WHEEL_SLOTS - 1));                                  \
+      _whl_e = (wheel)->_whl_slt[_whl_l][_whl_i]._list_fst;                 \
+      DLIST_NEW(&(wheel)->_whl_slt[_whl_l][_whl_i]);                        \
+      while (_whl_e != NULL) {                                              \
+        _whl_n = _LIST_NXT(_whl_e, link);                                   \
+        _WHEEL_PLACE(wheel, _whl_e, link);                                  \
+        _whl_e = _whl_n;                                                    \
+      }                                                                     \
+    }                                                                       \
+    _whl_i = (int)((wheel)->_whl_now & (WHEEL_SLOTS - 1));                  \
+    for (_whl_e = (wheel)->_whl_slt[0][_whl_i]._list_fst;                   \
+         _whl_e != NULL;                                                    \
+         _whl_e = _LIST_NXT(_whl_e, link))                                  \
+      _whl_e->link._whl_lvl = -1;                                           \
+    DLIST_APPEND(ready, &(wheel)->_whl_slt[0][_whl_i], link);               \
+  } while (0)
+
+/// Advance the timing wheel up to the given time and move the expired timers
+/// to the tail of the ready list, in the order of their expiry.
+///
+/// @param[in] wheel timing wheel
+/// @param[in] type  timer C type name
+/// @param[in] link  timer link name
+/// @param[in] ready ready list
+/// @param[in] now   new time in ticks
+#define WHEEL_ADVANCE(wheel, type, link, ready, now) \
+  do {                                               \
+    while ((wheel)->_whl_now < (uint64_t)(now))      \
+      WHEEL_TICK(wheel, type, link, ready);          \
+  } while (0)
+#endif